@@ -1,10 +1,8 @@
 /*
 analog_clock_raylib.c — Raylib analog clock using the original reactive.h
 
-This adapts the ASCII demo to a graphical window using raylib. It uses the
-original reactive.h header (unsafe factory functions in that header are NOT
-used — we construct static Signal objects and register them with
-register_signal(&s) to avoid dangling-pointer issues).
+This adapts the ASCII demo to a graphical window using raylib and
+reactive.h: three int signals for the time and three computed angles.
 
 Build (Linux example):
     gcc -std=c11 analog_clock_raylib.c -o analog_clock -lraylib -lm -lpthread
@@ -70,55 +68,17 @@ int main(void) {
   SetTargetFPS(60);
 
   /* Base signals (int) */
-  static Signal s_seconds = {0};
-  static Signal s_minutes = {0};
-  static Signal s_hours = {0};
-
-  s_seconds.type = SIG_INT;
-  s_seconds.val.i = 0;
-  s_seconds.dep_count = 0;
-  s_seconds.compute = NULL;
-  register_signal(&s_seconds);
-
-  s_minutes.type = SIG_INT;
-  s_minutes.val.i = 0;
-  s_minutes.dep_count = 0;
-  s_minutes.compute = NULL;
-  register_signal(&s_minutes);
-
-  s_hours.type = SIG_INT;
-  s_hours.val.i = 0;
-  s_hours.dep_count = 0;
-  s_hours.compute = NULL;
-  register_signal(&s_hours);
+  Signal *s_seconds = signal_int(0);
+  Signal *s_minutes = signal_int(0);
+  Signal *s_hours = signal_int(0);
 
   /* Computed signals (double angles) */
-  static Signal s_second_angle = {0};
-  static Signal s_minute_angle = {0};
-  static Signal s_hour_angle = {0};
-
-  s_second_angle.type = SIG_DOUBLE;
-  s_second_angle.val.d = 0.0;
-  s_second_angle.compute = compute_second_angle;
-  s_second_angle.dep_count = 1;
-  s_second_angle.deps[0] = &s_seconds;
-  register_signal(&s_second_angle);
-
-  s_minute_angle.type = SIG_DOUBLE;
-  s_minute_angle.val.d = 0.0;
-  s_minute_angle.compute = compute_minute_angle;
-  s_minute_angle.dep_count = 2;
-  s_minute_angle.deps[0] = &s_minutes;
-  s_minute_angle.deps[1] = &s_seconds;
-  register_signal(&s_minute_angle);
-
-  s_hour_angle.type = SIG_DOUBLE;
-  s_hour_angle.val.d = 0.0;
-  s_hour_angle.compute = compute_hour_angle;
-  s_hour_angle.dep_count = 2;
-  s_hour_angle.deps[0] = &s_hours;
-  s_hour_angle.deps[1] = &s_minutes;
-  register_signal(&s_hour_angle);
+  Signal *sec_deps[] = {s_seconds};
+  Signal *min_deps[] = {s_minutes, s_seconds};
+  Signal *hour_deps[] = {s_hours, s_minutes};
+  Signal *s_second_angle = signal_computed(compute_second_angle, sec_deps, 1);
+  Signal *s_minute_angle = signal_computed(compute_minute_angle, min_deps, 2);
+  Signal *s_hour_angle = signal_computed(compute_hour_angle, hour_deps, 2);
 
   /* track previous second to avoid redundant set_int calls */
   int prev_sec = -1;
@@ -131,15 +91,15 @@ int main(void) {
 
     if (tm_now.tm_sec != prev_sec) {
       prev_sec = tm_now.tm_sec;
-      set_int(&s_hours, tm_now.tm_hour);
-      set_int(&s_minutes, tm_now.tm_min);
-      set_int(&s_seconds, tm_now.tm_sec);
+      set_int(s_hours, tm_now.tm_hour);
+      set_int(s_minutes, tm_now.tm_min);
+      set_int(s_seconds, tm_now.tm_sec);
     }
 
     /* read computed angles (degrees, 0==12:00, increasing clockwise) */
-    double sec_ang = get_double(&s_second_angle);
-    double min_ang = get_double(&s_minute_angle);
-    double hour_ang = get_double(&s_hour_angle);
+    double sec_ang = get_double(s_second_angle);
+    double min_ang = get_double(s_minute_angle);
+    double hour_ang = get_double(s_hour_angle);
 
     /* convert to radians for drawing; use same convention as ASCII demo:
        x offset = sin(rad) * len, y offset = -cos(rad) * len so 0 deg points up
@@ -5,10 +5,10 @@
 #include <string.h>
 
 // Signals
-Signal input;
-Signal accumulator;
-Signal operation;
-Signal display;
+Signal *input;
+Signal *accumulator;
+Signal *operation;
+Signal *display;
 
 // ----- Computed Display -----
 void compute_display(Signal *self) {
@@ -27,18 +27,18 @@ void compute_display(Signal *self) {
 
 // ----- Calculator Logic -----
 void doOperation() {
-  const char *op = get_string(&operation);
+  const char *op = get_string(operation);
 
   // Only perform operation if one is set
   if (strlen(op) == 0) {
     // First number entry
-    set_double(&accumulator, atof(get_string(&input)));
-    set_string(&input, "0");
+    set_double(accumulator, atof(get_string(input)));
+    set_string(input, "0");
     return;
   }
 
-  double a = get_double(&accumulator);
-  double b = atof(get_string(&input));
+  double a = get_double(accumulator);
+  double b = atof(get_string(input));
 
   if (strcmp(op, "+") == 0)
     a += b;
@@ -49,40 +49,40 @@ void doOperation() {
   else if (strcmp(op, "/") == 0 && b != 0)
     a /= b;
 
-  set_double(&accumulator, a);
-  set_string(&input, "0");
+  set_double(accumulator, a);
+  set_string(input, "0");
 }
 
 void pressDigit(char c) {
   char buf[256];
-  const char *curr = get_string(&input);
+  const char *curr = get_string(input);
 
   if (strcmp(curr, "0") == 0)
     snprintf(buf, sizeof(buf), "%c", c);
   else
     snprintf(buf, sizeof(buf), "%s%c", curr, c);
 
-  set_string(&input, buf);
+  set_string(input, buf);
 }
 
 void pressOp(const char *op) {
   doOperation();
-  set_string(&operation, op);
+  set_string(operation, op);
 }
 
 void pressEq() {
   doOperation();
-  set_string(&operation, "");
+  set_string(operation, "");
 
   char buf[256];
-  snprintf(buf, sizeof(buf), "%g", get_double(&accumulator));
-  set_string(&input, buf);
+  snprintf(buf, sizeof(buf), "%g", get_double(accumulator));
+  set_string(input, buf);
 }
 
 void pressClear() {
-  set_string(&input, "0");
-  set_double(&accumulator, 0);
-  set_string(&operation, "");
+  set_string(input, "0");
+  set_double(accumulator, 0);
+  set_string(operation, "");
 }
 
 // ----- UI Button -----
@@ -108,15 +108,9 @@ int main() {
   accumulator = signal_double(0.0);
   operation = signal_string("");
 
-  // Register signals for auto-propagation
-  register_signal(&input);
-  register_signal(&accumulator);
-  register_signal(&operation);
-
   // Create computed display signal
-  Signal *deps[] = {&input, &accumulator, &operation};
+  Signal *deps[] = {input, accumulator, operation};
   display = signal_computed(compute_display, deps, 3);
-  register_signal(&display);
 
   while (!WindowShouldClose()) {
     BeginDrawing();
@@ -125,7 +119,7 @@ int main() {
     // Display (automatically updated!)
     DrawRectangle(20, 20, 360, 100, RAYWHITE);
     DrawRectangleLines(20, 20, 360, 100, GRAY);
-    DrawText(get_string(&display), 30, 50, 40, BLACK);
+    DrawText(get_string(display), 30, 50, 40, BLACK);
 
     // Buttons
     const char *L[4][4] = {{"7", "8", "9", "/"},
@@ -6,7 +6,7 @@
 // Computed signal: double the base value
 void compute_doubled(Signal *self) {
     Signal *base = self->deps[0];
-    self->val.i = get_int(base) * 2;
+    set_int(self, get_int(base) * 2);
 }
 
 int main() {
@@ -16,11 +16,11 @@ int main() {
     SetTargetFPS(60);
 
     // Base counter
-    Signal base = signal_int(0);
+    Signal *base = signal_int(0);
 
     // Doubled value (reactive)
-    Signal *deps[] = {&base};
-    Signal doubled = signal_computed(compute_doubled, deps, 1);
+    Signal *deps[] = {base};
+    Signal *doubled = signal_computed(compute_doubled, deps, 1);
 
     // Buttons
     const int btnW = 100, btnH = 40;
@@ -33,17 +33,17 @@ int main() {
 
         // Increment
         if (CheckCollisionPointRec(mouse, incBtn) && clicked) {
-            int newVal = get_int(&base) + 1;
-            set_int(&base, newVal);
-            printf("Base: %d → Doubled: %d\n", newVal, get_int(&doubled));
+            int newVal = get_int(base) + 1;
+            set_int(base, newVal);
+            printf("Base: %d → Doubled: %d\n", newVal, get_int(doubled));
             fflush(stdout);
         }
 
         // Decrement
         if (CheckCollisionPointRec(mouse, decBtn) && clicked) {
-            int newVal = get_int(&base) - 1;
-            set_int(&base, newVal);
-            printf("Base: %d → Doubled: %d\n", newVal, get_int(&doubled));
+            int newVal = get_int(base) - 1;
+            set_int(base, newVal);
+            printf("Base: %d → Doubled: %d\n", newVal, get_int(doubled));
             fflush(stdout);
         }
 
@@ -62,11 +62,11 @@ int main() {
 
         // Values
         char text1[64];
-        sprintf(text1, "Base: %d", get_int(&base));
+        sprintf(text1, "Base: %d", get_int(base));
         DrawText(text1, 300, 50, 24, DARKBLUE);
 
         char text2[64];
-        sprintf(text2, "Doubled: %d", get_int(&doubled));
+        sprintf(text2, "Doubled: %d", get_int(doubled));
         DrawText(text2, 300, 90, 24, MAROON);
 
         EndDrawing();
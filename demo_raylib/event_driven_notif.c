@@ -1,9 +1,10 @@
 
+#include "../lib/eventbus.h"
 #include "raylib.h"
 #include <string.h>
 #include <stdio.h>
 
-// === Event Bus (from earlier) =======================================
+// === Events (bus: ../lib/eventbus.h) ===============================
 typedef enum { EVENT_NOTIFICATION_PUSH, EVENT_NOTIFICATION_CLEAR_ALL } EventType;
 
 typedef struct {
@@ -11,30 +12,6 @@ typedef struct {
     float duration;
 } NotificationPayload;
 
-typedef struct {
-    EventType type;
-    union {
-        NotificationPayload notif;
-    };
-} Event;
-
-typedef void (*EventCallback)(Event e);
-
-#define MAX_SUBSCRIBERS 32
-typedef struct {
-    EventCallback subs[MAX_SUBSCRIBERS];
-    int count;
-} EventBus;
-
-void bus_init(EventBus *bus) { bus->count = 0; }
-void bus_subscribe(EventBus *bus, EventCallback cb) {
-    if (bus->count < MAX_SUBSCRIBERS) bus->subs[bus->count++] = cb;
-}
-void bus_publish(EventBus *bus, Event e) {
-    for (int i = 0; i < bus->count; i++)
-        bus->subs[i](e);
-}
-
 // === Notifications ===================================================
 #define MAX_NOTIFICATIONS 16
 typedef struct {
@@ -50,22 +27,25 @@ typedef struct {
 
 NotificationManager notif_mgr;
 
-void notif_event_handler(Event e) {
-    if (e.type == EVENT_NOTIFICATION_PUSH) {
-        for (int i = 0; i < MAX_NOTIFICATIONS; i++) {
-            if (!notif_mgr.list[i].active) {
-                strcpy(notif_mgr.list[i].message, e.notif.message);
-                notif_mgr.list[i].duration = e.notif.duration;
-                notif_mgr.list[i].timer = 0.0f;
-                notif_mgr.list[i].active = 1;
-                break;
-            }
+void notif_push_handler(const eb_event_t *ev, void *ctx) {
+    const NotificationPayload *n = EB_PAYLOAD(ev, NotificationPayload);
+    (void)ctx;
+    for (int i = 0; i < MAX_NOTIFICATIONS; i++) {
+        if (!notif_mgr.list[i].active) {
+            strcpy(notif_mgr.list[i].message, n->message);
+            notif_mgr.list[i].duration = n->duration;
+            notif_mgr.list[i].timer = 0.0f;
+            notif_mgr.list[i].active = 1;
+            break;
         }
     }
-    else if (e.type == EVENT_NOTIFICATION_CLEAR_ALL) {
-        for (int i = 0; i < MAX_NOTIFICATIONS; i++)
-            notif_mgr.list[i].active = 0;
-    }
+}
+
+void notif_clear_handler(const eb_event_t *ev, void *ctx) {
+    (void)ev;
+    (void)ctx;
+    for (int i = 0; i < MAX_NOTIFICATIONS; i++)
+        notif_mgr.list[i].active = 0;
 }
 
 void notif_update(float dt) {
@@ -99,28 +79,26 @@ void notif_draw(void) {
 int main(void) {
     InitWindow(800, 450, "Raylib Notification System (Event Bus)");
 
-    EventBus bus;
-    bus_init(&bus);
-    bus_subscribe(&bus, notif_event_handler);
+    eb_bus_t bus;
+    eb_init(&bus);
+    eb_subscribe(&bus, EVENT_NOTIFICATION_PUSH, notif_push_handler, NULL);
+    eb_subscribe(&bus, EVENT_NOTIFICATION_CLEAR_ALL, notif_clear_handler, NULL);
 
     SetTargetFPS(60);
 
     while (!WindowShouldClose()) {
         float dt = GetFrameTime();
 
-        // TEST EVENTS
+        // TEST EVENTS (queued, delivered once per frame)
         if (IsKeyPressed(KEY_N)) {
-            Event e = {
-                .type = EVENT_NOTIFICATION_PUSH,
-                .notif = {"Hello notification!", 2.0f}
-            };
-            bus_publish(&bus, e);
+            NotificationPayload n = {"Hello notification!", 2.0f};
+            eb_post(&bus, EVENT_NOTIFICATION_PUSH, &n, sizeof(n));
         }
 
-        if (IsKeyPressed(KEY_C)) {
-            Event e = { .type = EVENT_NOTIFICATION_CLEAR_ALL };
-            bus_publish(&bus, e);
-        }
+        if (IsKeyPressed(KEY_C))
+            eb_post(&bus, EVENT_NOTIFICATION_CLEAR_ALL, NULL, 0);
+
+        eb_dispatch(&bus);
 
         // Update notifications
         notif_update(dt);
@@ -136,6 +114,7 @@ int main(void) {
         EndDrawing();
     }
 
+    eb_free(&bus);
     CloseWindow();
     return 0;
 }
@@ -15,14 +15,14 @@
 #define HISTORY_SIZE 60
 
 // Signals
-Signal cpu_percent;
-Signal ram_percent;
-Signal ram_used_mb;
-Signal ram_total_mb;
+Signal *cpu_percent;
+Signal *ram_percent;
+Signal *ram_used_mb;
+Signal *ram_total_mb;
 
 // Computed displays
-Signal cpu_text;
-Signal ram_text;
+Signal *cpu_text;
+Signal *ram_text;
 
 // History for graphs
 float cpu_history[HISTORY_SIZE] = {0};
@@ -150,10 +150,10 @@ void update_system_stats() {
   get_ram_usage(&ram_pct, &ram_used, &ram_total);
 
   // Update signals (triggers reactive updates!)
-  set_double(&cpu_percent, cpu);
-  set_double(&ram_percent, ram_pct);
-  set_double(&ram_used_mb, ram_used);
-  set_double(&ram_total_mb, ram_total);
+  set_double(cpu_percent, cpu);
+  set_double(ram_percent, ram_pct);
+  set_double(ram_used_mb, ram_used);
+  set_double(ram_total_mb, ram_total);
 
   // Update history
   cpu_history[history_index] = cpu;
@@ -216,19 +216,13 @@ int main() {
   ram_used_mb = signal_double(0.0);
   ram_total_mb = signal_double(0.0);
 
-  register_signal(&cpu_percent);
-  register_signal(&ram_percent);
-  register_signal(&ram_used_mb);
-  register_signal(&ram_total_mb);
+  // Create computed text signals (lazy: formatted when drawn, and only
+  // after a reading changed)
+  Signal *cpu_deps[] = {cpu_percent};
+  cpu_text = signal_lazy(compute_cpu_text, cpu_deps, 1);
 
-  // Create computed text signals
-  Signal *cpu_deps[] = {&cpu_percent};
-  cpu_text = signal_computed(compute_cpu_text, cpu_deps, 1);
-  register_signal(&cpu_text);
-
-  Signal *ram_deps[] = {&ram_percent, &ram_used_mb, &ram_total_mb};
-  ram_text = signal_computed(compute_ram_text, ram_deps, 3);
-  register_signal(&ram_text);
+  Signal *ram_deps[] = {ram_percent, ram_used_mb, ram_total_mb};
+  ram_text = signal_lazy(compute_ram_text, ram_deps, 3);
 
   // Initialize CPU monitoring
   init_cpu_monitor();
@@ -251,13 +245,13 @@ int main() {
     DrawText("SYSTEM MONITOR", 20, 20, 30, WHITE);
 
     // CPU Section
-    DrawText(get_string(&cpu_text), 20, 70, 24, SKYBLUE);
-    draw_bar(20, 100, 460, 40, get_double(&cpu_percent), SKYBLUE);
+    DrawText(get_string(cpu_text), 20, 70, 24, SKYBLUE);
+    draw_bar(20, 100, 460, 40, get_double(cpu_percent), SKYBLUE);
     draw_graph(20, 150, 460, 150, cpu_history, SKYBLUE);
 
     // RAM Section
-    DrawText(get_string(&ram_text), 20, 320, 24, LIME);
-    draw_bar(20, 350, 460, 40, get_double(&ram_percent), LIME);
+    DrawText(get_string(ram_text), 20, 320, 24, LIME);
+    draw_bar(20, 350, 460, 40, get_double(ram_percent), LIME);
     draw_graph(20, 400, 460, 150, ram_history, LIME);
 
     // Footer
@@ -10,14 +10,15 @@
 #define WINDOW_HEIGHT 600
 
 typedef struct {
-    Signal pid;
-    Signal name;
-    Signal mem_kb;
+    Signal *pid;
+    Signal *name;
+    Signal *mem_kb;
 } ReactiveProcess;
 
 ReactiveProcess processes[MAX_PROCESSES];
 int process_count = 0;
-Signal total_mem;
+Signal *total_mem;
+int total_mem_deps = 0;
 
 // ===== Gather processes into reactive signals =====
 void update_process_signals() {
@@ -26,6 +27,7 @@ void update_process_signals() {
     if (!dp) return;
 
     int count = 0;
+    reactive_batch_begin(); // total_mem recomputes once per scan
     while ((entry = readdir(dp)) != NULL && count < MAX_PROCESSES) {
         int pid = atoi(entry->d_name);
         if (pid <= 0) continue;
@@ -48,35 +50,43 @@ void update_process_signals() {
         fclose(fp);
 
         // Initialize or update signals
-        if (count >= process_count) {
+        if (!processes[count].pid) {
             processes[count].pid = signal_int(pid);
             processes[count].name = signal_string(name);
             processes[count].mem_kb = signal_int(mem);
         } else {
-            set_int(&processes[count].pid, pid);
-            set_string(&processes[count].name, name);
-            set_int(&processes[count].mem_kb, mem);
+            set_int(processes[count].pid, pid);
+            set_string(processes[count].name, name);
+            set_int(processes[count].mem_kb, mem);
         }
         count++;
     }
     process_count = count;
     closedir(dp);
+    reactive_batch_end();
 }
 
 // ===== Computed total memory =====
 void compute_total_mem(Signal *self) {
     int sum = 0;
-    for (int i = 0; i < process_count; i++)
-        sum += get_int(&processes[i].mem_kb);
+    for (int i = 0; i < self->dep_count; i++)
+        sum += get_int(self->deps[i]);
     set_int(self, sum);
 }
 
+// Rewired only when the process count changes; otherwise the mem_kb
+// signals it reads are the same and updates reach it on their own
 void setup_total_mem() {
+    if (total_mem && total_mem_deps == process_count)
+        return;
+
     Signal *deps[MAX_PROCESSES];
     for (int i = 0; i < process_count; i++)
-        deps[i] = &processes[i].mem_kb;
+        deps[i] = processes[i].mem_kb;
 
+    signal_free(total_mem);
     total_mem = signal_computed(compute_total_mem, deps, process_count);
+    total_mem_deps = process_count;
 }
 
 // ===== Main =====
@@ -97,7 +107,7 @@ int main(void) {
         ClearBackground(DARKGRAY);
 
         // Total memory
-        DrawText(TextFormat("Total MEM: %d KB", get_int(&total_mem)), 50, 20, 20, YELLOW);
+        DrawText(TextFormat("Total MEM: %d KB", get_int(total_mem)), 50, 20, 20, YELLOW);
 
         // Table header
         DrawText("PID", 50, 50, 18, WHITE);
@@ -107,9 +117,9 @@ int main(void) {
         // Render each process
         for (int i = 0; i < process_count; i++) {
             int y = 80 + i * 20;
-            DrawText(TextFormat("%d", get_int(&processes[i].pid)), 50, y, 16, LIGHTGRAY);
-            DrawText(get_string(&processes[i].name), 150, y, 16, LIGHTGRAY);
-            DrawText(TextFormat("%d", get_int(&processes[i].mem_kb)), 400, y, 16, LIGHTGRAY);
+            DrawText(TextFormat("%d", get_int(processes[i].pid)), 50, y, 16, LIGHTGRAY);
+            DrawText(get_string(processes[i].name), 150, y, 16, LIGHTGRAY);
+            DrawText(TextFormat("%d", get_int(processes[i].mem_kb)), 400, y, 16, LIGHTGRAY);
         }
 
         EndDrawing();
@@ -0,0 +1,301 @@
+/*
+ * arena.h — Growable chained arena allocator (C11)
+ *
+ * Allocation is a pointer bump inside the current block; when it is full a
+ * new block is chained on (no abort, no copying). Everything is released at
+ * once with arena_reset() / arena_free(), and arena_mark() / arena_rewind()
+ * give cheap scratch scopes:
+ *
+ *   arena_t a;
+ *   arena_init(&a, 0);                      // 0 = ARENA_DEFAULT_BLOCK
+ *   for (each request) {
+ *     arena_mark_t m = arena_mark(&a);
+ *     char *line = arena_strdup(&a, input);
+ *     node_t *n = arena_new(&a, node_t);
+ *     ...
+ *     arena_rewind(&a, m);                  // drop this request's memory
+ *   }
+ *   arena_free(&a);
+ *
+ * arena_reset() keeps the first block, so an arena reused every frame or
+ * request settles into zero malloc calls.
+ *
+ * With ARENA_HUGEPAGES in the flags of arena_init_ex(), blocks of 2 MiB or
+ * more are mmap'd with MAP_HUGETLB, falling back to transparent huge pages
+ * (madvise) when no hugetlbfs pages are reserved. Linux only; elsewhere the
+ * flag is ignored.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/* Huge-page blocks need MAP_ANONYMOUS, which strict -std=c11 hides unless
+ * the includer defines _DEFAULT_SOURCE (or _GNU_SOURCE) before any system
+ * header; without it ARENA_HUGEPAGES falls back to ARENA_MALLOC. */
+#if defined(__linux__) && defined(MAP_ANONYMOUS)
+#define ARENA__MMAP 1
+#endif
+
+/* Configuration */
+#ifndef ARENA_DEFAULT_BLOCK
+#define ARENA_DEFAULT_BLOCK ((size_t)64 * 1024)
+#endif
+
+#ifndef ARENA_DEFAULT_ALIGN
+#define ARENA_DEFAULT_ALIGN alignof(max_align_t)
+#endif
+
+/* Optional: custom allocators for heap-backed blocks */
+#ifndef ARENA_MALLOC
+#define ARENA_MALLOC malloc
+#endif
+
+#ifndef ARENA_FREE
+#define ARENA_FREE free
+#endif
+
+/* Optional: OOM handler (string describing failed op). If it returns, the
+ * allocation evaluates to NULL. */
+#ifndef ARENA_ON_OOM
+#define ARENA_ON_OOM(msg) abort()
+#endif
+
+#define ARENA_HUGEPAGES 1u
+#define ARENA_HUGEPAGE_SIZE ((size_t)2 * 1024 * 1024)
+
+typedef struct arena_block {
+  struct arena_block *prev; /* older block */
+  size_t size;              /* usable bytes in data[] */
+  size_t used;
+  size_t map_size; /* != 0 when the block was mmap'd */
+  alignas(max_align_t) unsigned char data[];
+} arena_block_t;
+
+typedef struct {
+  arena_block_t *head;  /* current (newest) block */
+  arena_block_t *spare; /* one released block kept for reuse */
+  size_t block_size;
+  unsigned flags;
+} arena_t;
+
+typedef struct {
+  arena_block_t *block;
+  size_t used;
+} arena_mark_t;
+
+/* ========================= block management ========================= */
+
+static inline arena_block_t *arena__map_block(size_t total, unsigned flags) {
+#ifdef ARENA__MMAP
+  if ((flags & ARENA_HUGEPAGES) && total >= ARENA_HUGEPAGE_SIZE) {
+    size_t len = (total + ARENA_HUGEPAGE_SIZE - 1) & ~(ARENA_HUGEPAGE_SIZE - 1);
+    void *p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (p == MAP_FAILED) {
+      p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+               -1, 0);
+#ifdef MADV_HUGEPAGE
+      if (p != MAP_FAILED)
+        madvise(p, len, MADV_HUGEPAGE);
+#endif
+    }
+    if (p == MAP_FAILED)
+      return NULL;
+    arena_block_t *b = (arena_block_t *)p;
+    b->map_size = len;
+    b->size = len - sizeof(arena_block_t);
+    return b;
+  }
+#else
+  (void)flags;
+#endif
+  arena_block_t *b = (arena_block_t *)ARENA_MALLOC(total);
+  if (!b)
+    return NULL;
+  b->map_size = 0;
+  b->size = total - sizeof(arena_block_t);
+  return b;
+}
+
+static inline void arena__release_block(arena_block_t *b) {
+#ifdef ARENA__MMAP
+  if (b->map_size) {
+    munmap(b, b->map_size);
+    return;
+  }
+#endif
+  ARENA_FREE(b);
+}
+
+/* Free a block, or keep it as the spare if it is a default-sized one */
+static inline void arena__retire(arena_t *a, arena_block_t *b) {
+  if (!a->spare && b->size >= a->block_size) {
+    a->spare = b;
+    return;
+  }
+  arena__release_block(b);
+}
+
+static inline arena_block_t *arena__new_block(arena_t *a, size_t min_size) {
+  arena_block_t *b;
+  if (a->spare && a->spare->size >= min_size) {
+    b = a->spare;
+    a->spare = NULL;
+  } else {
+    size_t want = min_size > a->block_size ? min_size : a->block_size;
+    b = arena__map_block(sizeof(arena_block_t) + want, a->flags);
+    if (!b)
+      return NULL;
+  }
+  b->used = 0;
+  b->prev = a->head;
+  a->head = b;
+  return b;
+}
+
+/* ========================= lifecycle ========================= */
+
+static inline void arena_init_ex(arena_t *a, size_t block_size,
+                                 unsigned flags) {
+  a->head = NULL;
+  a->spare = NULL;
+  a->block_size = block_size ? block_size : ARENA_DEFAULT_BLOCK;
+  a->flags = flags;
+}
+
+static inline void arena_init(arena_t *a, size_t block_size) {
+  arena_init_ex(a, block_size, 0);
+}
+
+/* Release every block */
+static inline void arena_free(arena_t *a) {
+  arena_block_t *b = a->head;
+  while (b) {
+    arena_block_t *prev = b->prev;
+    arena__release_block(b);
+    b = prev;
+  }
+  if (a->spare)
+    arena__release_block(a->spare);
+  a->head = NULL;
+  a->spare = NULL;
+}
+
+/* ========================= allocation ========================= */
+
+/* align must be a power of two */
+static inline void *arena_alloc_aligned(arena_t *a, size_t size,
+                                        size_t align) {
+  arena_block_t *b = a->head;
+  if (b) {
+    uintptr_t base = (uintptr_t)b->data;
+    size_t off = ((base + b->used + align - 1) & ~(uintptr_t)(align - 1)) - base;
+    if (off <= b->size && size <= b->size - off) {
+      b->used = off + size;
+      return b->data + off;
+    }
+  }
+
+  /* Worst-case padding once the data start is max_align_t aligned */
+  size_t pad = align > alignof(max_align_t) ? align - 1 : 0;
+  if (size > SIZE_MAX - sizeof(arena_block_t) - pad ||
+      !(b = arena__new_block(a, size + pad))) {
+    ARENA_ON_OOM("arena block allocation failed");
+    return NULL;
+  }
+  uintptr_t base = (uintptr_t)b->data;
+  size_t off = ((base + align - 1) & ~(uintptr_t)(align - 1)) - base;
+  b->used = off + size;
+  return b->data + off;
+}
+
+static inline void *arena_alloc(arena_t *a, size_t size) {
+  return arena_alloc_aligned(a, size, ARENA_DEFAULT_ALIGN);
+}
+
+static inline void *arena_calloc(arena_t *a, size_t n, size_t size) {
+  if (size && n > SIZE_MAX / size)
+    return NULL;
+  void *p = arena_alloc(a, n * size);
+  if (p)
+    memset(p, 0, n * size);
+  return p;
+}
+
+#define arena_new(a, Type)                                                     \
+  ((Type *)arena_alloc_aligned((a), sizeof(Type), alignof(Type)))
+#define arena_new_array(a, Type, n)                                            \
+  ((Type *)arena_alloc_aligned((a), sizeof(Type) * (size_t)(n), alignof(Type)))
+
+static inline void *arena_memdup(arena_t *a, const void *src, size_t n) {
+  void *p = arena_alloc_aligned(a, n, 1);
+  if (p && n)
+    memcpy(p, src, n);
+  return p;
+}
+
+static inline char *arena_strndup(arena_t *a, const char *s, size_t n) {
+  char *p = (char *)arena_alloc_aligned(a, n + 1, 1);
+  if (p) {
+    memcpy(p, s, n);
+    p[n] = '\0';
+  }
+  return p;
+}
+
+static inline char *arena_strdup(arena_t *a, const char *s) {
+  return arena_strndup(a, s, strlen(s));
+}
+
+/* ========================= scopes ========================= */
+
+static inline arena_mark_t arena_mark(const arena_t *a) {
+  arena_mark_t m = {a->head, a->head ? a->head->used : 0};
+  return m;
+}
+
+/* Drop everything allocated since m was taken */
+static inline void arena_rewind(arena_t *a, arena_mark_t m) {
+  while (a->head && a->head != m.block) {
+    arena_block_t *b = a->head;
+    a->head = b->prev;
+    arena__retire(a, b);
+  }
+  if (a->head)
+    a->head->used = m.used;
+}
+
+/* Drop everything but keep the first (oldest) block for reuse */
+static inline void arena_reset(arena_t *a) {
+  if (!a->head)
+    return;
+  while (a->head->prev) {
+    arena_block_t *b = a->head;
+    a->head = b->prev;
+    arena__retire(a, b);
+  }
+  a->head->used = 0;
+}
+
+/* Bytes handed out across all live blocks (including alignment padding) */
+static inline size_t arena_used(const arena_t *a) {
+  size_t n = 0;
+  for (const arena_block_t *b = a->head; b; b = b->prev)
+    n += b->used;
+  return n;
+}
+
+#endif /* ARENA_H */
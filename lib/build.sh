@@ -6,3 +6,31 @@ gcc -o tui_snake tui_snake.c $(pkg-config --cflags --libs ncurses)
 
 gcc -o tui_sysmonitor tui_sysmonitor.c $(pkg-config --cflags --libs ncurses)
 
+
+gcc -std=c11 -O2 -o ringbuf_demo ringbuf_demo.c
+
+gcc -std=c11 -O2 -pthread -o metrics_demo metrics_demo.c
+
+gcc -std=c11 -O2 -pthread -o metrics_bench metrics_bench.c
+
+gcc -std=c11 -O2 -pthread -o once_bench once_bench.c
+
+gcc -std=c11 -O2 -pthread -o slab_alloc_bench slab_alloc_bench.c
+
+gcc -std=c11 -O2 -o arena_demo arena_demo.c
+
+gcc -std=c11 -O2 -pthread -o pool_demo pool_demo.c
+gcc -std=c11 -O2 -DMEMTRACK -o memtrack_demo memtrack_demo.c
+gcc -std=c11 -O2 -o dynarray_small_bench dynarray_small_bench.c
+gcc -std=c11 -O2 -o dynarray_simd_bench dynarray_simd_bench.c
+gcc -std=c11 -O2 -o slotmap_demo slotmap_demo.c
+gcc -std=c11 -O3 -fno-math-errno -fno-trapping-math -o soa_bench soa_bench.c -lm
+gcc -std=c11 -O2 -o deque_demo deque_demo.c
+gcc -std=c11 -O2 -o deque_bench deque_bench.c
+gcc -std=c11 -O2 -o str_slice_demo str_slice_demo.c
+gcc -std=c11 -O2 -o str_slice_bench str_slice_bench.c
+gcc -std=c11 -O2 -o strbuilder_bench strbuilder_bench.c
+gcc -std=c11 -O2 -o numfmt_bench numfmt_bench.c
+gcc -std=c11 -O2 -o reactive_bench reactive_bench.c
+gcc -std=c11 -O2 -o eventbus_bench eventbus_bench.c
+gcc -std=c11 -O2 -pthread -o eventbus_mt_bench eventbus_mt_bench.c
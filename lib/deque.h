@@ -0,0 +1,275 @@
+/*
+ * deque.h — Type-generic chunked deque for C (C99+)
+ *
+ * Elements live in fixed chunks of DQ_CHUNK (64) slots instead of one
+ * malloc'd node per element, and a small ring of chunk pointers (the map)
+ * tracks them in order:
+ *
+ *   map:  [ c0 | c1 | c2 ]       off = 61, count = 70
+ *   c0:   . . . ... . x x x      <- front lives at c0[61]
+ *   c1:   x x x ... x x x x
+ *   c2:   x x x . . ... . .      <- back lives at c2[2]
+ *
+ * push/pop at both ends are O(1) (a chunk is allocated or released once
+ * every 64 operations, and one empty chunk is cached so a queue that
+ * hovers around a chunk boundary does not thrash malloc), dq_at(i) is
+ * O(1), and dq_foreach walks each chunk as a plain array. Elements never
+ * move once pushed, so pointers to them stay valid until they are popped
+ * (unlike da_t, whose elements move on every realloc).
+ *
+ * Example:
+ *   dq_t(int) q = {0};
+ *   dq_push_back(q, 1);
+ *   dq_push_front(q, 0);
+ *   int v;
+ *   while (dq_pop_front(q, &v))
+ *     printf("%d\n", v);
+ *   dq_free(q);
+ */
+
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Configuration */
+#ifndef DQ_CHUNK
+#define DQ_CHUNK 64 /* elements per chunk; must be a power of two */
+#endif
+
+#ifndef DQ_INIT_MAP
+#define DQ_INIT_MAP 8 /* initial chunk-pointer slots; power of two */
+#endif
+
+/* Optional: custom allocators */
+#ifndef DQ_MALLOC
+#define DQ_MALLOC malloc
+#endif
+
+#ifndef DQ_FREE
+#define DQ_FREE free
+#endif
+
+/* Optional: OOM handler (string describing failed op) */
+#ifndef DQ_ON_OOM
+#define DQ_ON_OOM(msg) abort()
+#endif
+
+/* Bookkeeping shared by every dq_t(Type) */
+typedef struct {
+  size_t head;    /* free-running map index of the first chunk */
+  size_t nchunks; /* chunks in use */
+  size_t map_cap; /* map slots (power of two), 0 before the first push */
+  size_t off;     /* slot of the front element inside the first chunk */
+  size_t count;
+  void *spare; /* one cached empty chunk */
+} dq_index_t;
+
+/* Public type: deque of Type. Zero-initialize it ({0}) before use. */
+#define dq_t(Type)                                                             \
+  struct {                                                                     \
+    Type **map; /* ring of chunk pointers */                                   \
+    dq_index_t idx;                                                            \
+  }
+
+/* ========================= internals ========================= */
+
+static inline void *dq__chunk_new(dq_index_t *x, size_t item_size) {
+  void *c = x->spare;
+  if (c) {
+    x->spare = NULL;
+    return c;
+  }
+  c = DQ_MALLOC(DQ_CHUNK * item_size);
+  if (!c)
+    DQ_ON_OOM("deque chunk allocation failed");
+  return c;
+}
+
+static inline void dq__chunk_release(dq_index_t *x, void *c) {
+  if (x->spare)
+    DQ_FREE(c);
+  else
+    x->spare = c;
+}
+
+/* Make room for one more chunk pointer; returns the (possibly new) map,
+ * with the chunks moved to slots 0..nchunks-1 */
+static inline void **dq__map_room(dq_index_t *x, void **map) {
+  if (x->nchunks < x->map_cap)
+    return map;
+  size_t cap = x->map_cap ? x->map_cap * 2 : DQ_INIT_MAP;
+  void **m = (void **)DQ_MALLOC(cap * sizeof *m);
+  if (!m) {
+    DQ_ON_OOM("deque map allocation failed");
+    return NULL;
+  }
+  for (size_t k = 0; k < x->nchunks; k++)
+    m[k] = map[(x->head + k) & (x->map_cap - 1)];
+  DQ_FREE(map);
+  x->head = 0;
+  x->map_cap = cap;
+  return m;
+}
+
+/* Append an empty chunk; on OOM the deque is left unchanged */
+static inline void *dq__add_back(dq_index_t *x, void *map, size_t item_size) {
+  void **m = dq__map_room(x, (void **)map);
+  if (!m)
+    return map;
+  void *c = dq__chunk_new(x, item_size);
+  if (c) {
+    m[(x->head + x->nchunks) & (x->map_cap - 1)] = c;
+    x->nchunks++;
+  }
+  return m;
+}
+
+/* Prepend an empty chunk and point off past its end */
+static inline void *dq__add_front(dq_index_t *x, void *map,
+                                  size_t item_size) {
+  void **m = dq__map_room(x, (void **)map);
+  if (!m)
+    return map;
+  void *c = dq__chunk_new(x, item_size);
+  if (c) {
+    x->head--;
+    m[x->head & (x->map_cap - 1)] = c;
+    x->nchunks++;
+    x->off = DQ_CHUNK;
+  }
+  return m;
+}
+
+/* An empty deque keeps no chunks, so both ends start on a fresh one */
+static inline void dq__drop_all(dq_index_t *x, void *map) {
+  void **m = (void **)map;
+  while (x->nchunks) {
+    x->nchunks--;
+    dq__chunk_release(x, m[(x->head + x->nchunks) & (x->map_cap - 1)]);
+  }
+  x->head = 0;
+  x->off = 0;
+  x->count = 0;
+}
+
+static inline void dq__drop_front(dq_index_t *x, void *map) {
+  x->count--;
+  if (++x->off == DQ_CHUNK) {
+    void **m = (void **)map;
+    dq__chunk_release(x, m[x->head & (x->map_cap - 1)]);
+    x->head++;
+    x->nchunks--;
+    x->off = 0;
+  }
+  if (x->count == 0)
+    dq__drop_all(x, map);
+}
+
+static inline void dq__drop_back(dq_index_t *x, void *map) {
+  x->count--;
+  if (x->count == 0) {
+    dq__drop_all(x, map);
+  } else if (x->off + x->count == (x->nchunks - 1) * DQ_CHUNK) {
+    void **m = (void **)map;
+    x->nchunks--;
+    dq__chunk_release(x, m[(x->head + x->nchunks) & (x->map_cap - 1)]);
+  }
+}
+
+/* First slot / number of live slots of the k-th chunk, for dq_foreach */
+static inline size_t dq__seg_first(const dq_index_t *x, size_t k) {
+  return k == 0 ? x->off : 0;
+}
+
+static inline size_t dq__seg_len(const dq_index_t *x, size_t k) {
+  size_t end = x->off + x->count - k * DQ_CHUNK;
+  if (end > DQ_CHUNK)
+    end = DQ_CHUNK;
+  return end - dq__seg_first(x, k);
+}
+
+/* Lvalue of element i (no bounds check) */
+#define dq__ref(d, i)                                                          \
+  ((d).map[((d).idx.head + ((d).idx.off + (i)) / DQ_CHUNK) &                   \
+           ((d).idx.map_cap - 1)][((d).idx.off + (i)) % DQ_CHUNK])
+
+/* ========================= public API ========================= */
+
+#define dq_count(d) ((d).idx.count)
+#define dq_empty(d) ((d).idx.count == 0)
+
+/* Element access; i < dq_count(d), not bounds checked. All are lvalues. */
+#define dq_at(d, i) dq__ref(d, (size_t)(i))
+#define dq_front(d) dq__ref(d, 0)
+#define dq_back(d) dq__ref(d, (d).idx.count - 1)
+
+/* Variadic like da_push so compound literals need no extra parentheses */
+#define dq_push_back(d, ...)                                                   \
+  do {                                                                         \
+    if ((d).idx.off + (d).idx.count == (d).idx.nchunks * DQ_CHUNK)             \
+      (d).map = dq__add_back(&(d).idx, (d).map, sizeof **(d).map);             \
+    if ((d).idx.off + (d).idx.count < (d).idx.nchunks * DQ_CHUNK) {            \
+      dq__ref(d, (d).idx.count) = (__VA_ARGS__);                               \
+      (d).idx.count++;                                                         \
+    }                                                                          \
+  } while (0)
+
+#define dq_push_front(d, ...)                                                  \
+  do {                                                                         \
+    if ((d).idx.off == 0)                                                      \
+      (d).map = dq__add_front(&(d).idx, (d).map, sizeof **(d).map);            \
+    if ((d).idx.off) {                                                         \
+      (d).idx.off--;                                                           \
+      (d).idx.count++;                                                         \
+      dq__ref(d, 0) = (__VA_ARGS__);                                           \
+    }                                                                          \
+  } while (0)
+
+/* Pop into *out; evaluate to true on success, false if the deque is empty */
+#define dq_pop_front(d, out)                                                   \
+  (dq_count(d) ? (*(out) = dq_front(d), dq__drop_front(&(d).idx, (d).map),     \
+                  true)                                                        \
+               : false)
+
+#define dq_pop_back(d, out)                                                    \
+  (dq_count(d)                                                                 \
+       ? (*(out) = dq_back(d), dq__drop_back(&(d).idx, (d).map), true)         \
+       : false)
+
+/* Iterate front to back with a Type *p, one chunk at a time:
+ *   int *p;
+ *   dq_foreach(q, p) sum += *p;
+ * break and continue work as in a plain for; do not push or pop inside.
+ * The counters are named after the line, so loops on different lines nest.
+ * A break leaves the chunk's countdown above zero, which stops the outer
+ * loop too. */
+#define DQ__CAT2(a, b) a##b
+#define DQ__CAT(a, b) DQ__CAT2(a, b)
+#define DQ__S DQ__CAT(dq__s_, __LINE__)
+#define DQ__N DQ__CAT(dq__n_, __LINE__)
+
+#define dq_foreach(d, p)                                                       \
+  for (size_t DQ__S = 0, DQ__N = 0; DQ__N == 0 && DQ__S < (d).idx.nchunks;     \
+       DQ__S++)                                                                \
+    for ((p) = (d).map[((d).idx.head + DQ__S) & ((d).idx.map_cap - 1)] +       \
+               dq__seg_first(&(d).idx, DQ__S),                                 \
+        DQ__N = dq__seg_len(&(d).idx, DQ__S);                                  \
+         DQ__N; DQ__N--, (p)++)
+
+/* Remove everything (keeps the map and one cached chunk) */
+#define dq_clear(d) dq__drop_all(&(d).idx, (d).map)
+
+#define dq_free(d)                                                             \
+  do {                                                                         \
+    dq__drop_all(&(d).idx, (d).map);                                           \
+    DQ_FREE((d).idx.spare);                                                    \
+    DQ_FREE((d).map);                                                          \
+    (d).map = NULL;                                                            \
+    (d).idx = (dq_index_t){0};                                                 \
+  } while (0)
+
+#endif /* DEQUE_H */
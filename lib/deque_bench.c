@@ -0,0 +1,211 @@
+/*
+ * deque_bench.c — dq_t / ilist vs the node-per-element lists in reusables/
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 deque_bench.c -o deque_bench
+ *
+ * "node list" is reusables/ds_double_linkedlist.c (one malloc per element,
+ * prev/next/data per node) with a tail pointer added, since its
+ * insertDoublyEnd walks the whole list and would only measure that.
+ *   fifo    — push_back 1M ints, sum them front to back, pop_front all
+ *   churn   — a queue held at 1000 elements: push_back + pop_front 10M times
+ *   unlink  — link 1M objects, unlink every third by pointer, sum the rest;
+ *             ilist links objects in place, the node list mallocs a node each
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "deque.h"
+#include "ilist.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define N (1 << 20)
+#define CHURN_OPS 10000000
+#define CHURN_DEPTH 1000
+#define REPS 10
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static volatile long g_sink;
+
+/* ----- node-per-element doubly linked list (ds_double_linkedlist.c) ----- */
+
+typedef struct DoublyNode {
+  int data;
+  struct DoublyNode *prev;
+  struct DoublyNode *next;
+} DoublyNode;
+
+typedef struct {
+  DoublyNode *head, *tail;
+} DoublyList;
+
+static DoublyNode *list_push_back(DoublyList *l, int data) {
+  DoublyNode *n = malloc(sizeof *n);
+  n->data = data;
+  n->prev = l->tail;
+  n->next = NULL;
+  if (l->tail)
+    l->tail->next = n;
+  else
+    l->head = n;
+  l->tail = n;
+  return n;
+}
+
+static void list_unlink(DoublyList *l, DoublyNode *n) {
+  if (n->prev)
+    n->prev->next = n->next;
+  else
+    l->head = n->next;
+  if (n->next)
+    n->next->prev = n->prev;
+  else
+    l->tail = n->prev;
+  free(n);
+}
+
+static int list_pop_front(DoublyList *l) {
+  DoublyNode *n = l->head;
+  int v = n->data;
+  list_unlink(l, n);
+  return v;
+}
+
+/* ----- workloads ----- */
+
+static double fifo_list(void) {
+  double t0 = now_sec();
+  for (int r = 0; r < REPS; r++) {
+    DoublyList l = {0};
+    for (int i = 0; i < N; i++)
+      list_push_back(&l, i);
+    long sum = 0;
+    for (DoublyNode *n = l.head; n; n = n->next)
+      sum += n->data;
+    while (l.head)
+      sum -= list_pop_front(&l);
+    g_sink += sum;
+  }
+  return now_sec() - t0;
+}
+
+static double fifo_deque(void) {
+  double t0 = now_sec();
+  for (int r = 0; r < REPS; r++) {
+    dq_t(int) q = {0};
+    for (int i = 0; i < N; i++)
+      dq_push_back(q, i);
+    long sum = 0;
+    int *p, v;
+    dq_foreach(q, p) sum += *p;
+    while (dq_pop_front(q, &v))
+      sum -= v;
+    g_sink += sum;
+    dq_free(q);
+  }
+  return now_sec() - t0;
+}
+
+static double churn_list(void) {
+  DoublyList l = {0};
+  for (int i = 0; i < CHURN_DEPTH; i++)
+    list_push_back(&l, i);
+  long sum = 0;
+  double t0 = now_sec();
+  for (int i = 0; i < CHURN_OPS; i++) {
+    list_push_back(&l, i);
+    sum += list_pop_front(&l);
+  }
+  double t = now_sec() - t0;
+  while (l.head)
+    list_pop_front(&l);
+  g_sink += sum;
+  return t;
+}
+
+static double churn_deque(void) {
+  dq_t(int) q = {0};
+  for (int i = 0; i < CHURN_DEPTH; i++)
+    dq_push_back(q, i);
+  long sum = 0;
+  int v = 0;
+  double t0 = now_sec();
+  for (int i = 0; i < CHURN_OPS; i++) {
+    dq_push_back(q, i);
+    dq_pop_front(q, &v);
+    sum += v;
+  }
+  double t = now_sec() - t0;
+  dq_free(q);
+  g_sink += sum;
+  return t;
+}
+
+typedef struct {
+  int data;
+  ilist_node link;
+} item;
+
+static double unlink_list(void) {
+  DoublyNode **nodes = malloc(N * sizeof *nodes);
+  double t0 = now_sec();
+  for (int r = 0; r < REPS; r++) {
+    DoublyList l = {0};
+    for (int i = 0; i < N; i++)
+      nodes[i] = list_push_back(&l, i);
+    for (int i = 0; i < N; i += 3)
+      list_unlink(&l, nodes[i]);
+    long sum = 0;
+    for (DoublyNode *n = l.head; n; n = n->next)
+      sum += n->data;
+    while (l.head)
+      list_pop_front(&l);
+    g_sink += sum;
+  }
+  double t = now_sec() - t0;
+  free(nodes);
+  return t;
+}
+
+static double unlink_ilist(void) {
+  item *items = malloc(N * sizeof *items);
+  double t0 = now_sec();
+  for (int r = 0; r < REPS; r++) {
+    ilist_node head;
+    ilist_init(&head);
+    for (int i = 0; i < N; i++) {
+      items[i].data = i;
+      ilist_push_back(&head, &items[i].link);
+    }
+    for (int i = 0; i < N; i += 3)
+      ilist_unlink(&items[i].link);
+    long sum = 0;
+    ilist_node *it;
+    ilist_foreach(it, &head) sum += ilist_entry(it, item, link)->data;
+    g_sink += sum;
+  }
+  double t = now_sec() - t0;
+  free(items);
+  return t;
+}
+
+static void report(const char *name, const char *fast, double list_s,
+                   double fast_s, double ops) {
+  printf("  %-7s node list %7.2f ns/op   %-6s %7.2f ns/op   %5.2fx\n", name,
+         list_s * 1e9 / ops, fast, fast_s * 1e9 / ops, list_s / fast_s);
+}
+
+int main(void) {
+  printf("N = %d, chunk = %d elements\n", N, DQ_CHUNK);
+  report("fifo", "dq_t", fifo_list(), fifo_deque(), (double)N * REPS);
+  report("churn", "dq_t", churn_list(), churn_deque(), (double)CHURN_OPS);
+  report("unlink", "ilist", unlink_list(), unlink_ilist(), (double)N * REPS);
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * deque_demo.c — demo for deque.h and ilist.h
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 deque_demo.c -o deque_demo
+ */
+
+#include "deque.h"
+#include "ilist.h"
+#include <assert.h>
+#include <stdio.h>
+
+typedef struct {
+  int x, y;
+} cell;
+
+typedef struct {
+  int id;
+  int priority;
+  ilist_node link; /* on `ready` or `blocked` */
+} task;
+
+int main(void) {
+  /* Queue / stack at both ends */
+  dq_t(int) q = {0};
+  for (int i = 1; i <= 3; i++)
+    dq_push_back(q, i);
+  dq_push_front(q, 0);
+  dq_push_front(q, -1);
+  printf("front=%d back=%d count=%zu\n", dq_front(q), dq_back(q),
+         dq_count(q));
+  // Expected: front=-1 back=3 count=5
+
+  int v;
+  dq_pop_back(q, &v);
+  assert(v == 3);
+  dq_pop_front(q, &v);
+  assert(v == -1 && dq_at(q, 1) == 1);
+
+  /* Cross many chunk boundaries in both directions */
+  for (int i = 0; i < 1000; i++) {
+    dq_push_back(q, 1000 + i);
+    dq_push_front(q, -1000 - i);
+  }
+  assert(dq_count(q) == 2003);
+  long sum = 0;
+  int *p;
+  dq_foreach(q, p) sum += *p;
+  printf("sum=%ld\n", sum);
+  // Expected: sum=3
+
+  size_t n = 0;
+  while (dq_pop_front(q, &v))
+    n++;
+  assert(n == 2003 && dq_empty(q) && !dq_pop_back(q, &v));
+  dq_free(q);
+
+  /* Elements never move: pointers survive later pushes */
+  dq_t(cell) snake = {0};
+  dq_push_back(snake, (cell){5, 5});
+  cell *tail = &dq_front(snake);
+  for (int i = 1; i < 500; i++)
+    dq_push_back(snake, (cell){5 + i, 5});
+  printf("tail=(%d,%d) head=(%d,%d)\n", tail->x, tail->y, dq_back(snake).x,
+         dq_back(snake).y);
+  // Expected: tail=(5,5) head=(504,5)
+  dq_free(snake);
+
+  /* Intrusive list: tasks live in a plain array, lists only link them */
+  task tasks[5];
+  ilist_node ready, blocked;
+  ilist_init(&ready);
+  ilist_init(&blocked);
+  for (int i = 0; i < 5; i++) {
+    tasks[i] = (task){i, i % 3, {0}};
+    ilist_push_back(&ready, &tasks[i].link);
+  }
+
+  /* O(1) unlink from the middle by pointer, no search */
+  ilist_unlink(&tasks[2].link);
+  ilist_push_back(&blocked, &tasks[2].link);
+  ilist_unlink(&tasks[4].link);
+  ilist_push_front(&blocked, &tasks[4].link);
+
+  ilist_node *it;
+  printf("ready:");
+  ilist_foreach(it, &ready) printf(" %d", ilist_entry(it, task, link)->id);
+  printf("\n");
+  // Expected: ready: 0 1 3
+
+  /* Unblock everything in O(1), then drain */
+  ilist_splice_back(&ready, &blocked);
+  assert(ilist_empty(&blocked));
+  printf("drain:");
+  while ((it = ilist_pop_front(&ready)))
+    printf(" %d", ilist_entry(it, task, link)->id);
+  printf("\n");
+  // Expected: drain: 0 1 3 4 2
+  assert(!ilist_linked(&tasks[0].link));
+
+  printf("ok\n");
+  // Expected: ok
+  return 0;
+}
@@ -52,6 +52,9 @@ typedef struct {
   size_t capacity;
 } da_hdr_t;
 
+/* Set in capacity while the elements live in a da_small_t's inline buffer */
+#define DA__INLINE ((size_t)1 << (sizeof(size_t) * 8 - 1))
+
 /* Internal helpers */
 static inline da_hdr_t *da__hdr(const void *arr) {
   return arr ? ((da_hdr_t *)arr) - 1 : NULL;
@@ -59,7 +62,7 @@ static inline da_hdr_t *da__hdr(const void *arr) {
 
 static inline void *da__grow(void *arr, size_t min_cap, size_t item_size) {
   da_hdr_t *old_hdr = da__hdr(arr);
-  size_t old_cap = old_hdr ? old_hdr->capacity : 0;
+  size_t old_cap = old_hdr ? old_hdr->capacity & ~DA__INLINE : 0;
   size_t new_cap = old_cap ? old_cap * DA_GROWTH_FACTOR : DA_INIT_CAPACITY;
   if (new_cap < min_cap)
     new_cap = min_cap;
@@ -67,7 +70,12 @@ static inline void *da__grow(void *arr, size_t min_cap, size_t item_size) {
   size_t total = sizeof(da_hdr_t) + new_cap * item_size;
   da_hdr_t *new_hdr;
 
-  if (old_hdr) {
+  if (old_hdr && (old_hdr->capacity & DA__INLINE)) {
+    /* Spill out of inline storage: the buffer itself stays put */
+    new_hdr = (da_hdr_t *)DA_MALLOC(total);
+    if (new_hdr)
+      memcpy(new_hdr, old_hdr, sizeof(da_hdr_t) + old_hdr->count * item_size);
+  } else if (old_hdr) {
     new_hdr = (da_hdr_t *)DA_REALLOC(old_hdr, total);
   } else {
     new_hdr = (da_hdr_t *)DA_MALLOC(total);
@@ -86,7 +94,7 @@ static inline void *da__grow(void *arr, size_t min_cap, size_t item_size) {
 
 /* Query macros */
 #define da_count(a) ((a) ? da__hdr(a)->count : 0)
-#define da_capacity(a) ((a) ? da__hdr(a)->capacity : 0)
+#define da_capacity(a) ((a) ? da__hdr(a)->capacity & ~DA__INLINE : 0)
 #define da_empty(a) (da_count(a) == 0)
 #define da_size(a) da_count(a) /* alias */
 
@@ -94,7 +102,8 @@ static inline void *da__grow(void *arr, size_t min_cap, size_t item_size) {
 #define da_free(a)                                                             \
   do {                                                                         \
     if (a) {                                                                   \
-      DA_FREE(da__hdr(a));                                                     \
+      if (!(da__hdr(a)->capacity & DA__INLINE))                                \
+        DA_FREE(da__hdr(a));                                                   \
       (a) = NULL;                                                              \
     }                                                                          \
   } while (0)
@@ -129,7 +138,8 @@ static inline void *da__grow(void *arr, size_t min_cap, size_t item_size) {
 /* Shrink capacity to fit current count */
 #define da_shrink(a)                                                           \
   do {                                                                         \
-    if ((a) && da_count(a) < da_capacity(a)) {                                 \
+    if ((a) && da_count(a) < da_capacity(a) &&                                 \
+        !(da__hdr(a)->capacity & DA__INLINE)) {                                \
       size_t __size = sizeof(da_hdr_t) + da_count(a) * sizeof *(a);            \
       da_hdr_t *__h = (da_hdr_t *)DA_REALLOC(da__hdr(a), __size);              \
       if (__h) {                                                               \
@@ -139,6 +149,359 @@ static inline void *da__grow(void *arr, size_t min_cap, size_t item_size) {
     }                                                                          \
   } while (0)
 
+/* ===================== vectorized search / bulk ops =====================
+ *
+ * da_find, da_contains, da_remove_item and da_count_item compare 16 (SSE2)
+ * or 32 (AVX2, with -mavx2) bytes per step when the element type is a
+ * builtin integer, float or double; the type is picked with C11 _Generic,
+ * so other element types (pointers, structs with a user ==) and pre-C11
+ * compilers keep the scalar loop. Float compares use IEEE equality like ==
+ * (NaN never matches, -0.0 matches 0.0). The vector path needs the item
+ * to have the element type too; otherwise (say 3.5 in an int array) the
+ * scalar == loop runs, so the result is the same as plain C ==.
+ *
+ * da_reverse and da_fill work on raw bytes for any element type: 1/2/4/8
+ * byte elements are reversed or splatted 16 bytes at a time, everything
+ * else goes through memcpy without allocating.
+ *
+ * Define DA_NO_SIMD to force the scalar paths.
+ */
+
+#if !defined(DA_NO_SIMD) && defined(__GNUC__) &&                               \
+    (defined(__SSE2__) || defined(__AVX2__))
+#define DA__SIMD 1
+#ifdef __AVX2__
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+#endif
+
+#if defined(DA__SIMD) && defined(__AVX2__)
+#define DA__VBYTES 32
+typedef __m256i da__vec;
+#define da__vload(p) _mm256_loadu_si256((const __m256i *)(const void *)(p))
+#define da__vmask(v) ((uint32_t)_mm256_movemask_epi8(v))
+#define da__vzero() _mm256_setzero_si256()
+#define da__vsub8 _mm256_sub_epi8
+static inline size_t da__vhsum8(da__vec v) {
+  uint64_t lanes[4];
+  _mm256_storeu_si256((__m256i *)(void *)lanes,
+                      _mm256_sad_epu8(v, _mm256_setzero_si256()));
+  return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+#define da__splat_u8(x) _mm256_set1_epi8((char)(x))
+#define da__splat_u16(x) _mm256_set1_epi16((short)(x))
+#define da__splat_u32(x) _mm256_set1_epi32((int)(x))
+#define da__splat_u64(x) _mm256_set1_epi64x((long long)(x))
+#define da__splat_f32(x) _mm256_castps_si256(_mm256_set1_ps(x))
+#define da__splat_f64(x) _mm256_castpd_si256(_mm256_set1_pd(x))
+#define da__eq_u8 _mm256_cmpeq_epi8
+#define da__eq_u16 _mm256_cmpeq_epi16
+#define da__eq_u32 _mm256_cmpeq_epi32
+#define da__eq_u64 _mm256_cmpeq_epi64
+static inline da__vec da__eq_f32(da__vec a, da__vec b) {
+  return _mm256_castps_si256(_mm256_cmp_ps(
+      _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+}
+static inline da__vec da__eq_f64(da__vec a, da__vec b) {
+  return _mm256_castpd_si256(_mm256_cmp_pd(
+      _mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+}
+#elif defined(DA__SIMD)
+#define DA__VBYTES 16
+typedef __m128i da__vec;
+#define da__vload(p) _mm_loadu_si128((const __m128i *)(const void *)(p))
+#define da__vmask(v) ((uint32_t)_mm_movemask_epi8(v))
+#define da__vzero() _mm_setzero_si128()
+#define da__vsub8 _mm_sub_epi8
+static inline size_t da__vhsum8(da__vec v) {
+  uint64_t lanes[2];
+  _mm_storeu_si128((__m128i *)(void *)lanes,
+                   _mm_sad_epu8(v, _mm_setzero_si128()));
+  return (size_t)(lanes[0] + lanes[1]);
+}
+#define da__splat_u8(x) _mm_set1_epi8((char)(x))
+#define da__splat_u16(x) _mm_set1_epi16((short)(x))
+#define da__splat_u32(x) _mm_set1_epi32((int)(x))
+#define da__splat_u64(x) _mm_set1_epi64x((long long)(x))
+#define da__splat_f32(x) _mm_castps_si128(_mm_set1_ps(x))
+#define da__splat_f64(x) _mm_castpd_si128(_mm_set1_pd(x))
+#define da__eq_u8 _mm_cmpeq_epi8
+#define da__eq_u16 _mm_cmpeq_epi16
+#define da__eq_u32 _mm_cmpeq_epi32
+static inline da__vec da__eq_u64(da__vec a, da__vec b) {
+  /* SSE2 has no 64-bit compare: both 32-bit halves must match */
+  __m128i c = _mm_cmpeq_epi32(a, b);
+  return _mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+static inline da__vec da__eq_f32(da__vec a, da__vec b) {
+  return _mm_castps_si128(
+      _mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+static inline da__vec da__eq_f64(da__vec a, da__vec b) {
+  return _mm_castpd_si128(
+      _mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+#endif
+
+/* da__find_<sfx> / da__count_<sfx>: a compare sets all sizeof(T) bytes of
+ * each matching element, so find takes the first set bit of the byte mask
+ * and count adds up 0xFF bytes (as -1s, flushed before a byte can wrap) */
+#ifdef DA__SIMD
+#define DA__DEFINE_SEARCH(sfx, T)                                              \
+  static inline ptrdiff_t da__find_##sfx(const T *a, size_t n, T v) {          \
+    const size_t per = DA__VBYTES / sizeof(T);                                 \
+    const da__vec vv = da__splat_##sfx(v);                                     \
+    size_t i = 0;                                                              \
+    for (; i + per <= n; i += per) {                                           \
+      uint32_t m = da__vmask(da__eq_##sfx(da__vload(a + i), vv));              \
+      if (m)                                                                   \
+        return (ptrdiff_t)(i + (size_t)__builtin_ctz(m) / sizeof(T));          \
+    }                                                                          \
+    for (; i < n; i++)                                                         \
+      if (a[i] == v)                                                           \
+        return (ptrdiff_t)i;                                                   \
+    return -1;                                                                 \
+  }                                                                            \
+  static inline size_t da__count_##sfx(const T *a, size_t n, T v) {            \
+    const size_t per = DA__VBYTES / sizeof(T);                                 \
+    const da__vec vv = da__splat_##sfx(v);                                     \
+    da__vec acc = da__vzero();                                                 \
+    size_t i = 0, bytes = 0, c = 0;                                            \
+    unsigned k = 0;                                                            \
+    for (; i + per <= n; i += per) {                                           \
+      acc = da__vsub8(acc, da__eq_##sfx(da__vload(a + i), vv));                \
+      if (++k == 255) {                                                        \
+        bytes += da__vhsum8(acc);                                              \
+        acc = da__vzero();                                                     \
+        k = 0;                                                                 \
+      }                                                                        \
+    }                                                                          \
+    bytes += da__vhsum8(acc);                                                  \
+    for (; i < n; i++)                                                         \
+      c += a[i] == v;                                                          \
+    return c + bytes / sizeof(T);                                              \
+  }
+#else
+#define DA__DEFINE_SEARCH(sfx, T)                                              \
+  static inline ptrdiff_t da__find_##sfx(const T *a, size_t n, T v) {          \
+    for (size_t i = 0; i < n; i++)                                             \
+      if (a[i] == v)                                                           \
+        return (ptrdiff_t)i;                                                   \
+    return -1;                                                                 \
+  }                                                                            \
+  static inline size_t da__count_##sfx(const T *a, size_t n, T v) {            \
+    size_t c = 0;                                                              \
+    for (size_t i = 0; i < n; i++)                                             \
+      c += a[i] == v;                                                          \
+    return c;                                                                  \
+  }
+#endif
+
+DA__DEFINE_SEARCH(u8, uint8_t)
+DA__DEFINE_SEARCH(u16, uint16_t)
+DA__DEFINE_SEARCH(u32, uint32_t)
+DA__DEFINE_SEARCH(u64, uint64_t)
+DA__DEFINE_SEARCH(f32, float)
+DA__DEFINE_SEARCH(f64, double)
+
+/* Integers compare by bit pattern, so signedness only matters for the
+ * conversion of the item, which happens at the call */
+static inline ptrdiff_t da__find_bits(const void *a, size_t n, size_t es,
+                                      uint64_t v) {
+  switch (es) {
+  case 1: return da__find_u8((const uint8_t *)a, n, (uint8_t)v);
+  case 2: return da__find_u16((const uint16_t *)a, n, (uint16_t)v);
+  case 4: return da__find_u32((const uint32_t *)a, n, (uint32_t)v);
+  default: return da__find_u64((const uint64_t *)a, n, v);
+  }
+}
+
+static inline size_t da__count_bits(const void *a, size_t n, size_t es,
+                                    uint64_t v) {
+  switch (es) {
+  case 1: return da__count_u8((const uint8_t *)a, n, (uint8_t)v);
+  case 2: return da__count_u16((const uint16_t *)a, n, (uint16_t)v);
+  case 4: return da__count_u32((const uint32_t *)a, n, (uint32_t)v);
+  default: return da__count_u64((const uint64_t *)a, n, v);
+  }
+}
+
+#define DA__DEFINE_INT_SEARCH(name, T)                                         \
+  static inline ptrdiff_t da__find_##name(const void *a, size_t n, T v) {      \
+    return da__find_bits(a, n, sizeof(T), (uint64_t)v);                        \
+  }                                                                            \
+  static inline ptrdiff_t da__count_##name(const void *a, size_t n, T v) {     \
+    return (ptrdiff_t)da__count_bits(a, n, sizeof(T), (uint64_t)v);            \
+  }
+
+DA__DEFINE_INT_SEARCH(char, char)
+DA__DEFINE_INT_SEARCH(schar, signed char)
+DA__DEFINE_INT_SEARCH(uchar, unsigned char)
+DA__DEFINE_INT_SEARCH(short, short)
+DA__DEFINE_INT_SEARCH(ushort, unsigned short)
+DA__DEFINE_INT_SEARCH(int, int)
+DA__DEFINE_INT_SEARCH(uint, unsigned int)
+DA__DEFINE_INT_SEARCH(long, long)
+DA__DEFINE_INT_SEARCH(ulong, unsigned long)
+DA__DEFINE_INT_SEARCH(llong, long long)
+DA__DEFINE_INT_SEARCH(ullong, unsigned long long)
+
+static inline ptrdiff_t da__find_float(const void *a, size_t n, float v) {
+  return da__find_f32((const float *)a, n, v);
+}
+static inline ptrdiff_t da__count_float(const void *a, size_t n, float v) {
+  return (ptrdiff_t)da__count_f32((const float *)a, n, v);
+}
+static inline ptrdiff_t da__find_double(const void *a, size_t n, double v) {
+  return da__find_f64((const double *)a, n, v);
+}
+static inline ptrdiff_t da__count_double(const void *a, size_t n, double v) {
+  return (ptrdiff_t)da__count_f64((const double *)a, n, v);
+}
+
+/* Other element types: tell the caller to run its own == loop */
+#define DA__UNHANDLED ((ptrdiff_t)-2)
+static inline ptrdiff_t da__unhandled(const void *a, size_t n, ...) {
+  (void)a;
+  (void)n;
+  return DA__UNHANDLED;
+}
+
+/* The vector path only when item has the element type itself; any other
+ * item (3.5 against ints, a literal 3 against shorts) takes the scalar ==
+ * loop, so it compares with C's usual conversions instead of being cut
+ * down to the element type first */
+#define DA__SAME(T, item, fn) _Generic((item), T: fn, default: da__unhandled)
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define DA__DISPATCH(op, a, item)                                              \
+  _Generic((a)[0],                                                             \
+      char: DA__SAME(char, item, da__##op##_char),                             \
+      signed char: DA__SAME(signed char, item, da__##op##_schar),              \
+      unsigned char: DA__SAME(unsigned char, item, da__##op##_uchar),          \
+      short: DA__SAME(short, item, da__##op##_short),                          \
+      unsigned short: DA__SAME(unsigned short, item, da__##op##_ushort),       \
+      int: DA__SAME(int, item, da__##op##_int),                                \
+      unsigned int: DA__SAME(unsigned int, item, da__##op##_uint),             \
+      long: DA__SAME(long, item, da__##op##_long),                             \
+      unsigned long: DA__SAME(unsigned long, item, da__##op##_ulong),          \
+      long long: DA__SAME(long long, item, da__##op##_llong),                  \
+      unsigned long long: DA__SAME(unsigned long long, item,                   \
+                                   da__##op##_ullong),                         \
+      float: DA__SAME(float, item, da__##op##_float),                          \
+      double: DA__SAME(double, item, da__##op##_double),                       \
+      default: da__unhandled)
+#else
+#define DA__DISPATCH(op, a, item) da__unhandled
+#endif
+
+/* Index of the first element == item, -1 if none (a must be non-NULL) */
+#define da__find_index(a, item, out)                                           \
+  do {                                                                         \
+    (out) = DA__DISPATCH(find, a, item)((a), da_count(a), (item));             \
+    if ((out) == DA__UNHANDLED) {                                              \
+      (out) = -1;                                                              \
+      for (size_t __k = 0; __k < da_count(a); ++__k) {                         \
+        if ((a)[__k] == (item)) {                                              \
+          (out) = (ptrdiff_t)__k;                                              \
+          break;                                                               \
+        }                                                                      \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+
+#ifdef DA__SIMD
+/* Reverse the order of the 16 / es elements in a 16-byte vector */
+static inline __m128i da__rev128(__m128i v, size_t es) {
+  switch (es) {
+  case 1: /* swap the bytes of each pair, then reverse the pairs */
+    return da__rev128(
+        _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)), 2);
+  case 2:
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+  case 4:
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+  default:
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+  }
+}
+#endif
+
+static inline void da__swap_bytes(unsigned char *x, unsigned char *y,
+                                  size_t n) {
+  unsigned char t[64];
+  while (n) {
+    size_t k = n < sizeof t ? n : sizeof t;
+    memcpy(t, x, k);
+    memcpy(x, y, k);
+    memcpy(y, t, k);
+    x += k;
+    y += k;
+    n -= k;
+  }
+}
+
+static inline void da__reverse_bytes(void *base, size_t n, size_t es) {
+  unsigned char *lo = (unsigned char *)base, *hi = lo + n * es;
+#ifdef DA__SIMD
+  if (es == 1 || es == 2 || es == 4 || es == 8) {
+    /* Swap 16-byte blocks from both ends; the middle is left to the loop
+     * below, and stays a whole number of elements since es divides 16 */
+    while (hi - lo >= 32) {
+      __m128i l = _mm_loadu_si128((const __m128i *)(void *)lo);
+      __m128i h = _mm_loadu_si128((const __m128i *)(void *)(hi - 16));
+      _mm_storeu_si128((__m128i *)(void *)lo, da__rev128(h, es));
+      _mm_storeu_si128((__m128i *)(void *)(hi - 16), da__rev128(l, es));
+      lo += 16;
+      hi -= 16;
+    }
+  }
+#endif
+  while (hi - lo >= (ptrdiff_t)(2 * es)) {
+    hi -= es;
+    da__swap_bytes(lo, hi, es);
+    lo += es;
+  }
+}
+
+/* Copy element 0 over elements 1..n-1 */
+static inline void da__fill_bytes(void *base, size_t n, size_t es) {
+  unsigned char *p = (unsigned char *)base;
+  size_t total = n * es;
+  if (es == 1) {
+    memset(p + 1, p[0], total - 1);
+    return;
+  }
+#ifdef DA__SIMD
+  if (16 % es == 0 && total >= 16) {
+    unsigned char pat[16];
+    for (size_t k = 0; k < 16; k += es)
+      memcpy(pat + k, p, es);
+    __m128i v = _mm_loadu_si128((const __m128i *)(void *)pat);
+    size_t i = 0;
+    for (; i + 16 <= total; i += 16)
+      _mm_storeu_si128((__m128i *)(void *)(p + i), v);
+    memcpy(p + i, pat, total - i);
+    return;
+  }
+#endif
+  /* Doubling copies, capped so the source stays in L1 */
+  size_t chunk = 4096 / es * es, done = es;
+  if (!chunk)
+    chunk = es;
+  while (done < total) {
+    size_t k = done < chunk ? done : chunk;
+    if (k > total - done)
+      k = total - done;
+    memcpy(p + done, p, k);
+    done += k;
+  }
+}
+
 /* ===================== insertion / mutation ===================== */
 
 /* da_push: variadic so expressions containing commas (e.g. compound literals)
@@ -220,12 +583,11 @@ static inline void *da__grow(void *arr, size_t min_cap, size_t item_size) {
   do {                                                                         \
     (found) = false;                                                           \
     if (a) {                                                                   \
-      for (size_t __i = 0; __i < da_count(a); ++__i) {                         \
-        if ((a)[__i] == (item)) {                                              \
-          da_remove(a, __i);                                                   \
-          (found) = true;                                                      \
-          break;                                                               \
-        }                                                                      \
+      ptrdiff_t __at;                                                          \
+      da__find_index(a, item, __at);                                           \
+      if (__at >= 0) {                                                         \
+        da_remove(a, __at);                                                    \
+        (found) = true;                                                        \
       }                                                                        \
     }                                                                          \
   } while (0)
@@ -274,26 +636,16 @@ static inline void *da__grow(void *arr, size_t min_cap, size_t item_size) {
 
 #define da_reverse(a)                                                          \
   do {                                                                         \
-    if ((a) && da_count(a) > 1) {                                              \
-      for (size_t __i = 0, __n = da_count(a); __i < __n / 2; ++__i) {          \
-        size_t __j = __n - __i - 1;                                            \
-        /* swap via temporary buffer */                                        \
-        unsigned char __buf[256];                                              \
-        if (sizeof *(a) <= sizeof __buf) {                                     \
-          memcpy(__buf, &(a)[__i], sizeof *(a));                               \
-          memcpy(&(a)[__i], &(a)[__j], sizeof *(a));                           \
-          memcpy(&(a)[__j], __buf, sizeof *(a));                               \
-        } else {                                                               \
-          size_t __es = sizeof *(a);                                           \
-          unsigned char *__t = (unsigned char *)malloc(__es);                  \
-          if (__t) {                                                           \
-            memcpy(__t, &(a)[__i], __es);                                      \
-            memcpy(&(a)[__i], &(a)[__j], __es);                                \
-            memcpy(&(a)[__j], __t, __es);                                      \
-            free(__t);                                                         \
-          }                                                                    \
-        }                                                                      \
-      }                                                                        \
+    if ((a) && da_count(a) > 1)                                                \
+      da__reverse_bytes((a), da_count(a), sizeof *(a));                        \
+  } while (0)
+
+/* Set every element to value (count unchanged) */
+#define da_fill(a, value)                                                      \
+  do {                                                                         \
+    if ((a) && da_count(a) > 0) {                                              \
+      (a)[0] = (value);                                                        \
+      da__fill_bytes((a), da_count(a), sizeof *(a));                           \
     }                                                                          \
   } while (0)
 
@@ -313,12 +665,9 @@ static inline void *da__grow(void *arr, size_t min_cap, size_t item_size) {
   do {                                                                         \
     (result) = false;                                                          \
     if (a) {                                                                   \
-      for (size_t __i = 0; __i < da_count(a); ++__i) {                         \
-        if ((a)[__i] == (item)) {                                              \
-          (result) = true;                                                     \
-          break;                                                               \
-        }                                                                      \
-      }                                                                        \
+      ptrdiff_t __at;                                                          \
+      da__find_index(a, item, __at);                                           \
+      (result) = __at >= 0;                                                    \
     }                                                                          \
   } while (0)
 
@@ -326,13 +675,75 @@ static inline void *da__grow(void *arr, size_t min_cap, size_t item_size) {
   do {                                                                         \
     (index) = -1;                                                              \
     if (a) {                                                                   \
-      for (size_t __i = 0; __i < da_count(a); ++__i) {                         \
-        if ((a)[__i] == (item)) {                                              \
-          (index) = (int)__i;                                                  \
-          break;                                                               \
-        }                                                                      \
+      ptrdiff_t __at;                                                          \
+      da__find_index(a, item, __at);                                           \
+      (index) = (int)__at;                                                     \
+    }                                                                          \
+  } while (0)
+
+/* Number of elements == item, stored in n (size_t) */
+#define da_count_item(a, item, n)                                              \
+  do {                                                                         \
+    (n) = 0;                                                                   \
+    if (a) {                                                                   \
+      ptrdiff_t __c = DA__DISPATCH(count, a, item)((a), da_count(a), (item));  \
+      if (__c == DA__UNHANDLED) {                                              \
+        __c = 0;                                                               \
+        for (size_t __i = 0; __i < da_count(a); ++__i)                         \
+          __c += (a)[__i] == (item);                                           \
       }                                                                        \
+      (n) = (size_t)__c;                                                       \
     }                                                                          \
   } while (0)
 
+/* ===================== small-buffer arrays ===================== */
+
+/* da_small_t(Type, N): a dynamic array whose first N elements live inside
+ * the struct itself; only growing past N allocates (via DA_MALLOC), after
+ * which it behaves like any other da_t. The elements are always reached
+ * through `.data`, which works with every da_* macro above:
+ *
+ *   da_small_t(int, 8) ids;
+ *   da_small_init(ids);
+ *   da_push(ids.data, 42);            // no allocation yet
+ *   for (size_t i = 0; i < da_count(ids.data); i++) ...
+ *   da_small_free(ids);               // frees only if it spilled
+ *
+ * The inline header and buffer sit in the struct, so a da_small_t must not
+ * be copied or moved by value while da_small_is_inline() (its .data would
+ * still point into the old copy). Element alignment is limited to the same
+ * as heap dynarrays (that of long double / malloc). */
+#define da_small_t(Type, N)                                                    \
+  struct {                                                                     \
+    Type *data;                                                                \
+    union {                                                                    \
+      long double __align_ld;                                                  \
+      void *__align_p;                                                         \
+      long long __align_ll;                                                    \
+      unsigned char bytes[sizeof(da_hdr_t) + (N) * sizeof(Type)];              \
+    } store;                                                                   \
+  }
+
+static inline void *da__small_init(void *store, size_t capacity) {
+  da_hdr_t *h = (da_hdr_t *)store;
+  h->count = 0;
+  h->capacity = capacity | DA__INLINE;
+  return (void *)(h + 1);
+}
+
+#define da_small_init(s)                                                       \
+  ((s).data = da__small_init((s).store.bytes,                                  \
+                             (sizeof (s).store.bytes - sizeof(da_hdr_t)) /     \
+                                 sizeof *(s).data))
+
+#define da_small_is_inline(s)                                                  \
+  ((void *)(s).data == (void *)((s).store.bytes + sizeof(da_hdr_t)))
+
+/* Release any heap storage and go back to the (empty) inline buffer */
+#define da_small_free(s)                                                       \
+  do {                                                                         \
+    da_free((s).data);                                                         \
+    da_small_init(s);                                                          \
+  } while (0)
+
 #endif /* DYNARRAY_H */
@@ -0,0 +1,114 @@
+/*
+ * dynarray_small_bench.c — da_t vs da_small_t on short-lived small arrays
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 dynarray_small_bench.c -o dynarray_small_bench
+ *
+ * Churn workload: each round builds a fresh array of 1..12 ints (about 2 in
+ * 3 rounds stay within 8 elements), sums it and throws it away — the
+ * pattern of per-entity neighbour lists, hit lists or path scratch arrays.
+ *   heap   — da_t(int): malloc on first push, realloc at 9, free
+ *   small  — da_small_t(int, 8): no allocation unless it grows past 8
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "dynarray.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define ROUNDS 20000000L
+#define MAX_LEN 12
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static inline uint32_t xorshift(uint32_t *s) {
+  *s ^= *s << 13;
+  *s ^= *s >> 17;
+  *s ^= *s << 5;
+  return *s;
+}
+
+static void check_semantics(void) {
+  da_small_t(int, 4) s;
+  da_small_init(s);
+  assert(da_small_is_inline(s) && da_capacity(s.data) == 4);
+  for (int i = 0; i < 4; i++)
+    da_push(s.data, i);
+  assert(da_small_is_inline(s));
+  da_push(s.data, 4); /* spills to the heap, keeping the contents */
+  assert(!da_small_is_inline(s) && da_count(s.data) == 5);
+  for (int i = 0; i < 5; i++)
+    assert(s.data[i] == i);
+  da_insert(s.data, 0, -1);
+  da_reverse(s.data);
+  assert(s.data[0] == 4 && da_last(s.data) == -1);
+  da_small_free(s);
+  assert(da_small_is_inline(s) && da_count(s.data) == 0);
+
+  da_small_t(double, 2) d;
+  da_small_init(d);
+  da_resize(d.data, 2);
+  da_shrink(d.data); /* no-op while inline */
+  assert(da_small_is_inline(d) && d.data[1] == 0.0);
+  da_small_free(d);
+}
+
+static long long run_heap(void) {
+  uint32_t rng = 12345;
+  long long total = 0;
+  for (long r = 0; r < ROUNDS; r++) {
+    da_t(int) a = NULL;
+    int n = (int)(xorshift(&rng) % MAX_LEN) + 1;
+    for (int i = 0; i < n; i++)
+      da_push(a, i ^ (int)r);
+    for (size_t i = 0; i < da_count(a); i++)
+      total += a[i];
+    da_free(a);
+  }
+  return total;
+}
+
+static long long run_small(long *spills) {
+  uint32_t rng = 12345;
+  long long total = 0;
+  for (long r = 0; r < ROUNDS; r++) {
+    da_small_t(int, 8) a;
+    da_small_init(a);
+    int n = (int)(xorshift(&rng) % MAX_LEN) + 1;
+    for (int i = 0; i < n; i++)
+      da_push(a.data, i ^ (int)r);
+    for (size_t i = 0; i < da_count(a.data); i++)
+      total += a.data[i];
+    *spills += !da_small_is_inline(a);
+    da_small_free(a);
+  }
+  return total;
+}
+
+int main(void) {
+  check_semantics();
+
+  double t0 = now_sec();
+  long long h = run_heap();
+  double t_heap = now_sec() - t0;
+
+  long spills = 0;
+  t0 = now_sec();
+  long long s = run_small(&spills);
+  double t_small = now_sec() - t0;
+
+  assert(h == s);
+  printf("%ld rounds of 1..%d pushes, %.1f%% spilled past 8\n", ROUNDS,
+         MAX_LEN, 100.0 * (double)spills / (double)ROUNDS);
+  printf("  heap  da_t(int)          %6.2f ns/round\n",
+         t_heap * 1e9 / (double)ROUNDS);
+  printf("  small da_small_t(int, 8) %6.2f ns/round  (%.2fx)\n",
+         t_small * 1e9 / (double)ROUNDS, t_heap / t_small);
+  return 0;
+}
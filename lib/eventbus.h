@@ -0,0 +1,361 @@
+/*
+ * eventbus.h — Event bus with per-type subscriber vectors (C11)
+ *
+ * Event types are small integers (an enum); each one indexes straight into
+ * its own growable subscriber vector, so finding who to call is O(1) and
+ * there is no cap on types or subscribers. Handlers get the event by
+ * pointer; the payload is never copied on the synchronous path.
+ *
+ *   enum { EV_CLICK, EV_TICK };
+ *   typedef struct { int x, y; } click_t;
+ *
+ *   static void on_click(const eb_event_t *ev, void *ctx) {
+ *     const click_t *c = EB_PAYLOAD(ev, click_t);
+ *     ...
+ *   }
+ *
+ *   eb_bus_t bus;
+ *   eb_init(&bus);
+ *   eb_subscribe(&bus, EV_CLICK, on_click, ui);
+ *
+ *   click_t c = {10, 20};
+ *   eb_publish(&bus, EV_CLICK, &c, sizeof(c));  // handlers run now
+ *
+ *   eb_post(&bus, EV_CLICK, &c, sizeof(c));     // copied into this frame
+ *   ...
+ *   eb_dispatch(&bus);                          // once per frame
+ *   eb_free(&bus);
+ *
+ * Queued mode: eb_post() copies the payload into the current frame's arena
+ * and records the event. eb_dispatch() counting-sorts the frame by type
+ * (stable, so each type keeps its post order) and delivers it type by
+ * type, handler by handler: the first subscriber of a type gets all of
+ * that type's events, then the second, and so on, so one handler stays
+ * hot for the whole run. Unlike eb_publish(), the handlers of a type do
+ * not interleave per event; publish when that order matters. The arena
+ * is reset after the frame, so a steady stream settles into zero malloc
+ * calls. Frames are double-buffered: events posted by handlers during
+ * eb_dispatch() land in the next frame.
+ *
+ * Handlers may subscribe (to any type) while being dispatched. Removing a
+ * handler of the type being delivered makes the handler after it miss the
+ * current event (or, in eb_dispatch, the rest of the run). eb_dispatch()
+ * from inside a handler does nothing.
+ */
+
+#ifndef EVENTBUS_H
+#define EVENTBUS_H
+
+#include "arena.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Optional: custom allocators for the vectors (payloads use the arena) */
+#ifndef EB_REALLOC
+#define EB_REALLOC realloc
+#endif
+
+#ifndef EB_FREE
+#define EB_FREE free
+#endif
+
+/* Optional: OOM handler (string describing failed op). If it returns, the
+ * subscribe / post fails and returns false. */
+#ifndef EB_ON_OOM
+#define EB_ON_OOM(msg) abort()
+#endif
+
+typedef struct {
+  uint32_t type;
+  uint32_t size;    /* payload bytes */
+  const void *data; /* payload; for posted events, the frame's copy */
+} eb_event_t;
+
+/* The payload of ev as a const Type * */
+#define EB_PAYLOAD(ev, Type) ((const Type *)(ev)->data)
+
+typedef void (*eb_handler_t)(const eb_event_t *ev, void *ctx);
+
+typedef struct {
+  eb_handler_t fn;
+  void *ctx;
+} eb_sub_t;
+
+typedef struct {
+  eb_sub_t *items;
+  uint32_t count;
+  uint32_t cap;
+} eb_subs_t;
+
+typedef struct {
+  arena_t arena; /* payload copies */
+  eb_event_t *events;
+  size_t count;
+  size_t cap;
+} eb_frame_t;
+
+typedef struct {
+  eb_subs_t *types; /* indexed by event type */
+  uint32_t type_cap;
+
+  eb_frame_t frame[2]; /* posting into frame[cur] */
+  int cur;
+  bool dispatching;
+
+  /* eb_dispatch scratch, kept between frames */
+  eb_event_t *sorted;
+  size_t sorted_cap;
+  size_t *start; /* per-type offsets into sorted */
+  size_t start_cap;
+} eb_bus_t;
+
+/* ========================= internals ========================= */
+
+#if defined(__GNUC__)
+#define EB__LIKELY(x) __builtin_expect(!!(x), 1)
+#define EB__NOINLINE __attribute__((noinline, unused))
+#else
+#define EB__LIKELY(x) (x)
+#define EB__NOINLINE
+#endif
+
+/* Grow *items to hold at least `need` elements (doubling); NULL on OOM */
+static inline void *eb__grow(void *items, size_t *cap, size_t need,
+                             size_t elem) {
+  if (need <= *cap)
+    return items;
+  size_t n = *cap ? *cap : 8;
+  while (n < need)
+    n *= 2;
+  void *p = n > SIZE_MAX / elem ? NULL : EB_REALLOC(items, n * elem);
+  if (!p) {
+    EB_ON_OOM("eventbus: vector growth failed");
+    return NULL;
+  }
+  *cap = n;
+  return p;
+}
+
+/* Call every subscriber of ev->type. Re-reads the vector each step: a
+ * handler may subscribe, which can move it. */
+static inline void eb__deliver(eb_bus_t *bus, const eb_event_t *ev) {
+  for (uint32_t i = 0; i < bus->types[ev->type].count; i++) {
+    eb_sub_t sub = bus->types[ev->type].items[i];
+    sub.fn(ev, sub.ctx);
+  }
+}
+
+/* ========================= lifecycle ========================= */
+
+static inline void eb_init(eb_bus_t *bus) {
+  memset(bus, 0, sizeof(*bus));
+  arena_init(&bus->frame[0].arena, 0);
+  arena_init(&bus->frame[1].arena, 0);
+}
+
+static inline void eb_free(eb_bus_t *bus) {
+  for (uint32_t t = 0; t < bus->type_cap; t++)
+    EB_FREE(bus->types[t].items);
+  EB_FREE(bus->types);
+  for (int i = 0; i < 2; i++) {
+    arena_free(&bus->frame[i].arena);
+    EB_FREE(bus->frame[i].events);
+  }
+  EB_FREE(bus->sorted);
+  EB_FREE(bus->start);
+  memset(bus, 0, sizeof(*bus));
+}
+
+/* ========================= subscriptions ========================= */
+
+static inline bool eb_subscribe(eb_bus_t *bus, uint32_t type,
+                                eb_handler_t fn, void *ctx) {
+  if (type >= bus->type_cap) {
+    size_t cap = bus->type_cap;
+    eb_subs_t *types = (eb_subs_t *)eb__grow(bus->types, &cap,
+                                             (size_t)type + 1,
+                                             sizeof(eb_subs_t));
+    if (!types)
+      return false;
+    memset(types + bus->type_cap, 0,
+           (cap - bus->type_cap) * sizeof(eb_subs_t));
+    bus->types = types;
+    bus->type_cap = (uint32_t)cap;
+  }
+
+  eb_subs_t *subs = &bus->types[type];
+  size_t cap = subs->cap;
+  eb_sub_t *items = (eb_sub_t *)eb__grow(subs->items, &cap,
+                                         (size_t)subs->count + 1,
+                                         sizeof(eb_sub_t));
+  if (!items)
+    return false;
+  subs->items = items;
+  subs->cap = (uint32_t)cap;
+  subs->items[subs->count++] = (eb_sub_t){fn, ctx};
+  return true;
+}
+
+/* Remove the first subscription matching fn and ctx; order is kept */
+static inline bool eb_unsubscribe(eb_bus_t *bus, uint32_t type,
+                                  eb_handler_t fn, void *ctx) {
+  if (type >= bus->type_cap)
+    return false;
+  eb_subs_t *subs = &bus->types[type];
+  for (uint32_t i = 0; i < subs->count; i++) {
+    if (subs->items[i].fn == fn && subs->items[i].ctx == ctx) {
+      memmove(&subs->items[i], &subs->items[i + 1],
+              (subs->count - i - 1) * sizeof(eb_sub_t));
+      subs->count--;
+      return true;
+    }
+  }
+  return false;
+}
+
+static inline uint32_t eb_subscriber_count(const eb_bus_t *bus,
+                                           uint32_t type) {
+  return type < bus->type_cap ? bus->types[type].count : 0;
+}
+
+/* ========================= synchronous ========================= */
+
+/* Run the handlers of `type` now; data is only borrowed for the call */
+static inline void eb_publish(eb_bus_t *bus, uint32_t type, const void *data,
+                              uint32_t size) {
+  if (type >= bus->type_cap)
+    return;
+  eb_event_t ev = {type, size, data};
+  eb__deliver(bus, &ev);
+}
+
+/* ========================= queued ========================= */
+
+/* Pointer alignment is enough for small payloads; keeps the arena dense */
+#define EB__ALIGN(size)                                                        \
+  ((size) >= alignof(max_align_t) ? alignof(max_align_t) : sizeof(void *))
+
+/* eb_post when the frame's block or event vector is full */
+static EB__NOINLINE bool eb__post_slow(eb_bus_t *bus, uint32_t type,
+                                       const void *data, uint32_t size) {
+  eb_frame_t *f = &bus->frame[bus->cur];
+  void *copy = NULL;
+  if (size) {
+    copy = arena_alloc_aligned(&f->arena, size, EB__ALIGN(size));
+    if (!copy)
+      return false;
+    memcpy(copy, data, size);
+  }
+  eb_event_t *events = (eb_event_t *)eb__grow(f->events, &f->cap,
+                                              f->count + 1,
+                                              sizeof(eb_event_t));
+  if (!events)
+    return false;
+  f->events = events;
+  f->events[f->count++] = (eb_event_t){type, size, copy};
+  return true;
+}
+
+/*
+ * Copy the payload into this frame and queue the event for eb_dispatch.
+ * The common case bumps the arena's current block in place, so with a
+ * constant size the copy compiles to a few moves.
+ */
+static inline bool eb_post(eb_bus_t *bus, uint32_t type, const void *data,
+                           uint32_t size) {
+  eb_frame_t *f = &bus->frame[bus->cur];
+  arena_block_t *b = f->arena.head;
+  if (EB__LIKELY(b && f->count < f->cap && size)) {
+    /* data[] is max_align_t aligned, so aligning the offset is enough */
+    size_t off = (b->used + EB__ALIGN(size) - 1) & ~(EB__ALIGN(size) - 1);
+    if (EB__LIKELY(off <= b->size && size <= b->size - off)) {
+      b->used = off + size;
+      memcpy(b->data + off, data, size);
+      f->events[f->count++] = (eb_event_t){type, size, b->data + off};
+      return true;
+    }
+  }
+  return eb__post_slow(bus, type, data, size);
+}
+
+/* Events posted and not yet dispatched */
+static inline size_t eb_pending(const eb_bus_t *bus) {
+  return bus->frame[bus->cur].count;
+}
+
+/*
+ * Deliver the current frame grouped by type, then recycle its memory.
+ * Events of a type with no subscriber are dropped. Returns the number of
+ * events that reached at least one handler (0 when called from inside a
+ * handler).
+ */
+static inline size_t eb_dispatch(eb_bus_t *bus) {
+  if (bus->dispatching)
+    return 0;
+  eb_frame_t *f = &bus->frame[bus->cur];
+  bus->cur ^= 1;
+  size_t n = f->count;
+  if (n == 0)
+    return 0;
+  bus->dispatching = true;
+
+  /* Counting sort by type; bucket type_cap collects unsubscribed types */
+  uint32_t types = bus->type_cap;
+  eb_event_t *sorted =
+      (eb_event_t *)eb__grow(bus->sorted, &bus->sorted_cap, n,
+                             sizeof(eb_event_t));
+  if (sorted)
+    bus->sorted = sorted;
+  size_t *start = sorted ? (size_t *)eb__grow(bus->start, &bus->start_cap,
+                                              (size_t)types + 2,
+                                              sizeof(size_t))
+                         : NULL;
+  size_t delivered = 0;
+  if (start) {
+    bus->start = start;
+    memset(start, 0, ((size_t)types + 2) * sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {
+      uint32_t t = f->events[i].type < types ? f->events[i].type : types;
+      start[t + 1]++;
+    }
+    for (uint32_t t = 0; t < types; t++)
+      start[t + 1] += start[t];
+    for (size_t i = 0; i < n; i++) {
+      uint32_t t = f->events[i].type < types ? f->events[i].type : types;
+      sorted[start[t]++] = f->events[i];
+    }
+
+    /* The scatter left start[t] at the end of run t. Each handler takes
+     * the whole run before the next one starts, so the indirect call
+     * keeps hitting the same target. */
+    for (size_t begin = 0, t = 0; t < types; begin = start[t++]) {
+      if (bus->types[t].count)
+        delivered += start[t] - begin; /* runs nobody listens to are dropped */
+      for (uint32_t h = 0; h < bus->types[t].count; h++) {
+        eb_sub_t sub = bus->types[t].items[h];
+        for (size_t i = begin; i < start[t]; i++)
+          sub.fn(&sorted[i], sub.ctx);
+      }
+    }
+  }
+
+  /* A frame that spilled into several blocks gets one block that holds
+   * it all next time, so the steady state never chains or mallocs */
+  f->count = 0;
+  if (f->arena.head && f->arena.head->prev) {
+    size_t want = f->arena.block_size;
+    while (want < arena_used(&f->arena))
+      want *= 2;
+    arena_free(&f->arena);
+    arena_init(&f->arena, want);
+  } else {
+    arena_reset(&f->arena);
+  }
+  bus->dispatching = false;
+  return delivered;
+}
+
+#endif /* EVENTBUS_H */
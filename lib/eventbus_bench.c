@@ -0,0 +1,181 @@
+/*
+ * eventbus_bench.c — eventbus.h vs the fixed-array, by-value bus
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 eventbus_bench.c -o eventbus_bench
+ *
+ * "by value" is the bus in demo_raylib/event_driven_notif.c: fixed
+ * subscriber arrays (here one per type, as in reusables/event_system.c)
+ * and the whole Event union passed by value to every callback.
+ * 16 event types with 4 subscribers each; the type of each event comes
+ * from an LCG, so consecutive events rarely share a type.
+ *   small  — 16-byte payload (the union is still notification-sized)
+ *   notif  — 136-byte payload, a message and a duration
+ * eb_publish delivers each event by pointer on the spot; eb_post copies
+ * it into the frame arena and eb_dispatch delivers 4096-event frames
+ * grouped by type. Every mode must produce the same checksum.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "eventbus.h"
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+
+#define TYPES 16
+#define SUBS 4
+#define EVENTS 8000000
+#define FRAME 4096
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+typedef struct {
+  int a, b;
+  double c;
+} small_t;
+
+typedef struct {
+  char message[128];
+  double duration;
+} notif_t;
+
+static uint64_t g_sum;
+
+static void on_small(const small_t *p, uint32_t type) {
+  g_sum += (uint64_t)(p->a + p->b) + type;
+}
+
+static void on_notif(const notif_t *p, uint32_t type) {
+  g_sum += (uint64_t)(unsigned char)p->message[5] + (uint64_t)p->duration +
+           type;
+}
+
+/* ----- by-value bus (event_driven_notif.c) ----- */
+
+#define OLD_MAX_SUBSCRIBERS 32
+
+typedef struct {
+  uint32_t type;
+  union {
+    small_t small;
+    notif_t notif;
+  };
+} OldEvent;
+
+typedef void (*OldCallback)(OldEvent e);
+
+typedef struct {
+  OldCallback subs[TYPES][OLD_MAX_SUBSCRIBERS];
+  int count[TYPES];
+} OldBus;
+
+static void old_subscribe(OldBus *bus, uint32_t type, OldCallback cb) {
+  if (bus->count[type] < OLD_MAX_SUBSCRIBERS)
+    bus->subs[type][bus->count[type]++] = cb;
+}
+
+static void old_publish(OldBus *bus, OldEvent e) {
+  for (int i = 0; i < bus->count[e.type]; i++)
+    bus->subs[e.type][i](e);
+}
+
+static void old_small(OldEvent e) { on_small(&e.small, e.type); }
+static void old_notif(OldEvent e) { on_notif(&e.notif, e.type); }
+
+/* ----- eventbus.h ----- */
+
+static void eb_small(const eb_event_t *ev, void *ctx) {
+  (void)ctx;
+  on_small(EB_PAYLOAD(ev, small_t), ev->type);
+}
+
+static void eb_notif(const eb_event_t *ev, void *ctx) {
+  (void)ctx;
+  on_notif(EB_PAYLOAD(ev, notif_t), ev->type);
+}
+
+/* ----- driver ----- */
+
+typedef enum { MODE_OLD, MODE_PUBLISH, MODE_POST } bench_mode_t;
+
+static const char *mode_name[] = {"by value", "eb_publish", "eb_post"};
+
+static uint32_t next_type(uint32_t *s) {
+  *s = *s * 1664525u + 1013904223u;
+  return (*s >> 24) % TYPES;
+}
+
+/* Runs EVENTS events; returns events per second, sets *check */
+static double run(bench_mode_t mode, bool big, uint64_t *check) {
+  OldBus *old = calloc(1, sizeof(OldBus));
+  eb_bus_t bus;
+  eb_init(&bus);
+  for (uint32_t t = 0; t < TYPES; t++)
+    for (int i = 0; i < SUBS; i++) {
+      old_subscribe(old, t, big ? old_notif : old_small);
+      eb_subscribe(&bus, t, big ? eb_notif : eb_small, NULL);
+    }
+
+  OldEvent e = {0};
+  snprintf(e.notif.message, sizeof(e.notif.message), "event %d", 42);
+  uint32_t seed = 7;
+  g_sum = 0;
+  double t0 = now_sec();
+  for (int i = 0; i < EVENTS; i++) {
+    e.type = next_type(&seed);
+    if (big) {
+      e.notif.message[5] = (char)('0' + i % 10);
+      e.notif.duration = (double)(i & 7);
+    } else {
+      e.small = (small_t){i & 1023, 3, 0.5};
+    }
+
+    /* Constant sizes per call site, as real callers post them */
+    if (mode == MODE_OLD) {
+      old_publish(old, e);
+    } else if (mode == MODE_PUBLISH) {
+      if (big)
+        eb_publish(&bus, e.type, &e.notif, sizeof(notif_t));
+      else
+        eb_publish(&bus, e.type, &e.small, sizeof(small_t));
+    } else {
+      if (big)
+        eb_post(&bus, e.type, &e.notif, sizeof(notif_t));
+      else
+        eb_post(&bus, e.type, &e.small, sizeof(small_t));
+      if (eb_pending(&bus) == FRAME)
+        eb_dispatch(&bus);
+    }
+  }
+  eb_dispatch(&bus);
+  double rate = EVENTS / (now_sec() - t0);
+  *check = g_sum;
+  eb_free(&bus);
+  free(old);
+  return rate;
+}
+
+int main(void) {
+  printf("%d events, %d types x %d subscribers\n", EVENTS, TYPES, SUBS);
+  for (int big = 0; big <= 1; big++) {
+    uint64_t expect = 0;
+    double base = 0;
+    for (bench_mode_t m = MODE_OLD; m <= MODE_POST; m++) {
+      uint64_t check;
+      double rate = run(m, big, &check);
+      if (m == MODE_OLD) {
+        expect = check;
+        base = rate;
+      }
+      assert(check == expect);
+      printf("  %-6s %-11s %7.1f M events/s  %6.1f ns/event  %5.2fx\n",
+             big ? "notif" : "small", mode_name[m], rate / 1e6, 1e9 / rate,
+             rate / base);
+    }
+  }
+  return 0;
+}
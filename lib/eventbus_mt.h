@@ -0,0 +1,380 @@
+/*
+ * eventbus_mt.h — Cross-thread event delivery for eventbus.h (C11)
+ *
+ * Worker threads post events without taking a lock: each producer owns a
+ * single-producer / single-consumer byte ring, and exactly one thread — the
+ * one handlers are pinned to — drains every ring and runs the bus's
+ * handlers. A producer publishes with one atomic store; the drainer
+ * releases space back once per batch, so the two sides share a cache line
+ * once per batch rather than once per event.
+ *
+ *   eb_bus_t bus;
+ *   eb_init(&bus);
+ *   eb_subscribe(&bus, EV_JOB_DONE, on_job_done, ui);
+ *
+ *   ebmt_hub_t hub;
+ *   ebmt_init(&hub, &bus);
+ *   ebmt_start(&hub, -1);            // dispatcher thread (or a CPU to pin)
+ *
+ *   // in each worker thread, once:
+ *   ebmt_producer_t *out = ebmt_producer(&hub, 1 << 16, EBMT_BLOCK);
+ *   ...
+ *   ebmt_post(out, EV_JOB_DONE, &result, sizeof(result));
+ *
+ *   ebmt_stop(&hub);                 // delivers what is left, joins
+ *   ebmt_destroy(&hub);
+ *
+ * Instead of ebmt_start(), a thread of your choosing (say the render
+ * thread, which must own all raylib calls) can call ebmt_drain() once per
+ * frame; handlers then run there and nowhere else. Either way only one
+ * thread drains a hub, and subscriptions change only before draining
+ * starts or from inside handlers.
+ *
+ * Backpressure is bounded by the ring size given to ebmt_producer(). When
+ * a ring is full, EBMT_BLOCK spins and then yields until the drainer frees
+ * space (counted in `stalls`); EBMT_DROP fails the post instead (counted
+ * in `dropped`). Events of one producer arrive in post order; events of
+ * different producers are not ordered against each other. Payloads are
+ * handed to handlers straight from the ring, aligned like max_align_t,
+ * and stay valid until the handler returns.
+ *
+ * Compile with -pthread. Pinning the dispatcher thread to a CPU needs
+ * glibc's CPU_SET and pthread_setaffinity_np: define _GNU_SOURCE before
+ * including any system header, or the CPU argument is ignored.
+ */
+
+#ifndef EVENTBUS_MT_H
+#define EVENTBUS_MT_H
+
+#include "eventbus.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+
+/* Configuration */
+#ifndef EBMT_MAX_PRODUCERS
+#define EBMT_MAX_PRODUCERS 64
+#endif
+
+/* Polls before a blocked producer yields / the dispatcher thread parks */
+#ifndef EBMT_SPIN
+#define EBMT_SPIN 64
+#endif
+
+/* Records the drainer takes before releasing their space */
+#ifndef EBMT_BATCH
+#define EBMT_BATCH 64
+#endif
+
+#define EBMT_CACHE_LINE 64
+
+typedef enum { EBMT_BLOCK = 0, EBMT_DROP = 1 } ebmt_full_t;
+
+typedef struct ebmt_hub ebmt_hub_t;
+
+typedef struct {
+  /* written by the producer */
+  alignas(EBMT_CACHE_LINE) atomic_size_t head; /* bytes ever written */
+  size_t tail_cache;                           /* last tail it saw */
+  /* written by the drainer */
+  alignas(EBMT_CACHE_LINE) atomic_size_t tail; /* bytes ever released */
+  size_t head_cache;
+  /* fixed after ebmt_producer() */
+  alignas(EBMT_CACHE_LINE) unsigned char *ring;
+  size_t mask; /* ring bytes - 1 */
+  ebmt_full_t when_full;
+  ebmt_hub_t *hub;
+  atomic_size_t dropped; /* EBMT_DROP posts that found the ring full */
+  atomic_size_t stalls;  /* EBMT_BLOCK posts that had to wait */
+} ebmt_producer_t;
+
+struct ebmt_hub {
+  eb_bus_t *bus;
+  ebmt_producer_t *producers[EBMT_MAX_PRODUCERS];
+  atomic_size_t producer_count;
+
+  /* dispatcher thread */
+  pthread_t thread;
+  bool started;
+  atomic_bool running;
+  int cpu;
+
+  /* parking: the drainer sleeps on `wake` only after announcing it in
+   * `sleeping`; producers check the flag after publishing */
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  atomic_bool sleeping;
+};
+
+/* Record header; the payload follows at the next max_align_t boundary */
+typedef struct {
+  uint32_t type;
+  uint32_t size;
+} ebmt__rec_t;
+
+#define EBMT__ALIGN alignof(max_align_t)
+#define EBMT__HDR                                                              \
+  ((sizeof(ebmt__rec_t) + EBMT__ALIGN - 1) & ~(size_t)(EBMT__ALIGN - 1))
+#define EBMT__PAD UINT32_MAX /* skip to the start of the ring */
+
+static inline size_t ebmt__rec_bytes(uint32_t size) {
+  return EBMT__HDR + (((size_t)size + EBMT__ALIGN - 1) & ~(EBMT__ALIGN - 1));
+}
+
+/* ========================= lifecycle ========================= */
+
+static inline void ebmt_init(ebmt_hub_t *hub, eb_bus_t *bus) {
+  memset(hub, 0, sizeof(*hub));
+  hub->bus = bus;
+  hub->cpu = -1;
+  atomic_init(&hub->producer_count, 0);
+  atomic_init(&hub->running, false);
+  atomic_init(&hub->sleeping, false);
+  pthread_mutex_init(&hub->lock, NULL);
+  pthread_cond_init(&hub->wake, NULL);
+}
+
+/*
+ * A ring for one producer thread, `bytes` rounded up to a power of two;
+ * an event takes its payload plus 16-32 bytes of header and padding.
+ * NULL when EBMT_MAX_PRODUCERS are attached or memory runs out. Producers
+ * live until ebmt_destroy().
+ */
+static inline ebmt_producer_t *ebmt_producer(ebmt_hub_t *hub, size_t bytes,
+                                             ebmt_full_t when_full) {
+  size_t size = EBMT_CACHE_LINE; /* >= 2 headers; aligned_alloc multiple */
+  while (size < bytes)
+    size *= 2;
+  ebmt_producer_t *p = (ebmt_producer_t *)aligned_alloc(
+      EBMT_CACHE_LINE, (sizeof(ebmt_producer_t) + EBMT_CACHE_LINE - 1) &
+                           ~(size_t)(EBMT_CACHE_LINE - 1));
+  unsigned char *ring = (unsigned char *)aligned_alloc(EBMT_CACHE_LINE, size);
+  if (!p || !ring) {
+    free(p);
+    free(ring);
+    return NULL;
+  }
+  memset(p, 0, sizeof(*p));
+  atomic_init(&p->head, 0);
+  atomic_init(&p->tail, 0);
+  atomic_init(&p->dropped, 0);
+  atomic_init(&p->stalls, 0);
+  p->ring = ring;
+  p->mask = size - 1;
+  p->when_full = when_full;
+  p->hub = hub;
+
+  pthread_mutex_lock(&hub->lock);
+  size_t n = atomic_load_explicit(&hub->producer_count, memory_order_relaxed);
+  if (n == EBMT_MAX_PRODUCERS) {
+    pthread_mutex_unlock(&hub->lock);
+    free(ring);
+    free(p);
+    return NULL;
+  }
+  hub->producers[n] = p;
+  /* Publishes the slot to the drainer */
+  atomic_store_explicit(&hub->producer_count, n + 1, memory_order_release);
+  pthread_mutex_unlock(&hub->lock);
+  return p;
+}
+
+/* ========================= producing ========================= */
+
+/* After publishing: wake the drainer if it parked (or is about to). The
+ * seq_cst head store / sleeping load here pair with the drainer's
+ * sleeping store / head loads in ebmt__idle: one of them sees the other. */
+static inline void ebmt__wake(ebmt_hub_t *hub) {
+  if (atomic_load_explicit(&hub->sleeping, memory_order_seq_cst)) {
+    pthread_mutex_lock(&hub->lock);
+    pthread_cond_signal(&hub->wake);
+    pthread_mutex_unlock(&hub->lock);
+  }
+}
+
+/*
+ * Queue an event from the producer's thread; the payload is copied into the
+ * ring. Fails when the ring is full under EBMT_DROP, when the record could
+ * never fit (larger than half the ring), or for type UINT32_MAX, which the
+ * ring reserves as its wrap marker.
+ */
+static inline bool ebmt_post(ebmt_producer_t *p, uint32_t type,
+                             const void *data, uint32_t size) {
+  size_t cap = p->mask + 1;
+  size_t rec = ebmt__rec_bytes(size);
+  if (rec > cap / 2 || type == EBMT__PAD)
+    return false;
+
+  size_t head = atomic_load_explicit(&p->head, memory_order_relaxed);
+  size_t pos = head & p->mask;
+  size_t skip = cap - pos < rec ? cap - pos : 0; /* pad to wrap around */
+  size_t need = skip + rec;
+
+  if (need > cap - (head - p->tail_cache)) {
+    p->tail_cache = atomic_load_explicit(&p->tail, memory_order_acquire);
+    if (need > cap - (head - p->tail_cache)) {
+      if (p->when_full == EBMT_DROP) {
+        atomic_fetch_add_explicit(&p->dropped, 1, memory_order_relaxed);
+        return false;
+      }
+      atomic_fetch_add_explicit(&p->stalls, 1, memory_order_relaxed);
+      for (unsigned spin = 0;; spin++) {
+        ebmt__wake(p->hub);
+        if (spin >= EBMT_SPIN)
+          sched_yield();
+        p->tail_cache = atomic_load_explicit(&p->tail, memory_order_acquire);
+        if (need <= cap - (head - p->tail_cache))
+          break;
+      }
+    }
+  }
+
+  if (skip) {
+    ((ebmt__rec_t *)(p->ring + pos))->type = EBMT__PAD;
+    pos = 0;
+  }
+  ebmt__rec_t *r = (ebmt__rec_t *)(p->ring + pos);
+  r->type = type;
+  r->size = size;
+  if (size)
+    memcpy(p->ring + pos + EBMT__HDR, data, size);
+  atomic_store_explicit(&p->head, head + need, memory_order_seq_cst);
+  ebmt__wake(p->hub);
+  return true;
+}
+
+/* ========================= draining ========================= */
+
+/* Deliver one producer's queued events; returns how many */
+static inline size_t ebmt__drain_one(ebmt_hub_t *hub, ebmt_producer_t *p) {
+  size_t tail = atomic_load_explicit(&p->tail, memory_order_relaxed);
+  if (tail == p->head_cache) {
+    p->head_cache = atomic_load_explicit(&p->head, memory_order_acquire);
+    if (tail == p->head_cache)
+      return 0;
+  }
+
+  size_t events = 0, batch = 0;
+  while (tail != p->head_cache) {
+    size_t pos = tail & p->mask;
+    const ebmt__rec_t *r = (const ebmt__rec_t *)(p->ring + pos);
+    if (r->type == EBMT__PAD) {
+      tail += p->mask + 1 - pos;
+      continue;
+    }
+    eb_publish(hub->bus, r->type, p->ring + pos + EBMT__HDR, r->size);
+    tail += ebmt__rec_bytes(r->size);
+    events++;
+    if (++batch == EBMT_BATCH) {
+      /* Give the space back so a blocked producer can go on */
+      atomic_store_explicit(&p->tail, tail, memory_order_release);
+      batch = 0;
+      p->head_cache = atomic_load_explicit(&p->head, memory_order_acquire);
+    }
+  }
+  atomic_store_explicit(&p->tail, tail, memory_order_release);
+  return events;
+}
+
+/*
+ * Run the handlers of everything queued so far on the calling thread.
+ * Only one thread may drain a hub. Returns the number of events delivered.
+ */
+static inline size_t ebmt_drain(ebmt_hub_t *hub) {
+  size_t n = atomic_load_explicit(&hub->producer_count, memory_order_acquire);
+  size_t events = 0;
+  for (size_t i = 0; i < n; i++)
+    events += ebmt__drain_one(hub, hub->producers[i]);
+  return events;
+}
+
+static inline bool ebmt__idle(ebmt_hub_t *hub) {
+  size_t n = atomic_load_explicit(&hub->producer_count, memory_order_acquire);
+  for (size_t i = 0; i < n; i++) {
+    ebmt_producer_t *p = hub->producers[i];
+    if (atomic_load_explicit(&p->head, memory_order_seq_cst) !=
+        atomic_load_explicit(&p->tail, memory_order_relaxed))
+      return false;
+  }
+  return true;
+}
+
+static inline void *ebmt__dispatcher(void *arg) {
+  ebmt_hub_t *hub = (ebmt_hub_t *)arg;
+#ifdef CPU_SET
+  if (hub->cpu >= 0) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(hub->cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+#endif
+  unsigned idle = 0;
+  while (atomic_load_explicit(&hub->running, memory_order_acquire)) {
+    if (ebmt_drain(hub)) {
+      idle = 0;
+      continue;
+    }
+    if (++idle < EBMT_SPIN) {
+      sched_yield();
+      continue;
+    }
+    /* Park. Announce first, then look once more: a producer that
+     * published before seeing `sleeping` is caught by the re-check, one
+     * that published after it signals. */
+    pthread_mutex_lock(&hub->lock);
+    atomic_store_explicit(&hub->sleeping, true, memory_order_seq_cst);
+    if (ebmt__idle(hub) &&
+        atomic_load_explicit(&hub->running, memory_order_acquire))
+      pthread_cond_wait(&hub->wake, &hub->lock);
+    atomic_store_explicit(&hub->sleeping, false, memory_order_relaxed);
+    pthread_mutex_unlock(&hub->lock);
+    idle = 0;
+  }
+  ebmt_drain(hub);
+  return NULL;
+}
+
+/* Start a dispatcher thread that runs every handler; cpu >= 0 pins it to
+ * that CPU (glibc with _GNU_SOURCE only, ignored elsewhere) */
+static inline bool ebmt_start(ebmt_hub_t *hub, int cpu) {
+  if (hub->started)
+    return false;
+  hub->cpu = cpu;
+  atomic_store(&hub->running, true);
+  if (pthread_create(&hub->thread, NULL, ebmt__dispatcher, hub) != 0) {
+    atomic_store(&hub->running, false);
+    return false;
+  }
+  hub->started = true;
+  return true;
+}
+
+/* Stop the dispatcher thread after it has delivered everything posted so
+ * far. Producers must have stopped posting. */
+static inline void ebmt_stop(ebmt_hub_t *hub) {
+  if (!hub->started)
+    return;
+  pthread_mutex_lock(&hub->lock);
+  atomic_store(&hub->running, false);
+  pthread_cond_signal(&hub->wake);
+  pthread_mutex_unlock(&hub->lock);
+  pthread_join(hub->thread, NULL);
+  hub->started = false;
+}
+
+/* Stops the dispatcher if needed and frees every producer */
+static inline void ebmt_destroy(ebmt_hub_t *hub) {
+  ebmt_stop(hub);
+  size_t n = atomic_load(&hub->producer_count);
+  for (size_t i = 0; i < n; i++) {
+    free(hub->producers[i]->ring);
+    free(hub->producers[i]);
+  }
+  atomic_store(&hub->producer_count, 0);
+  pthread_mutex_destroy(&hub->lock);
+  pthread_cond_destroy(&hub->wake);
+}
+
+#endif /* EVENTBUS_MT_H */
@@ -0,0 +1,186 @@
+/*
+ * eventbus_mt_bench.c — eventbus_mt.h SPSC rings vs one mutex-guarded queue
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 -pthread eventbus_mt_bench.c -o eventbus_mt_bench
+ *
+ * Run:
+ *   ./eventbus_mt_bench [events]     (default 4000000)
+ *
+ * 1, 2 and 4 producer threads post the events between them (16-byte
+ * payload: producer, sequence number, value) to one consumer thread that
+ * runs the handler. The handler checks that each producer's events arrive
+ * in order; the blocking modes must deliver every event.
+ *   mutex  — producers lock, eb_post, unlock; the consumer locks and runs
+ *            eb_dispatch (a lock on every post, contended with the drain)
+ *   spsc   — ebmt_post into a 64 KiB ring per producer, EBMT_BLOCK;
+ *            ebmt_start's dispatcher thread drains
+ *   drop   — as spsc with 4 KiB EBMT_DROP rings: what is lost when the
+ *            consumer cannot keep up and producers must not wait
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "eventbus_mt.h"
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_THREADS 4
+#define EV_SAMPLE 0
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+typedef struct {
+  uint32_t producer;
+  uint32_t seq;
+  uint64_t value;
+} sample_t;
+
+/* Consumer side; only ever touched by the consuming thread */
+static int g_events = 4000000;
+static uint32_t g_next_seq[MAX_THREADS];
+static uint64_t g_sum;
+static uint64_t g_delivered;
+
+static void on_sample(const eb_event_t *ev, void *ctx) {
+  const sample_t *s = EB_PAYLOAD(ev, sample_t);
+  (void)ctx;
+  assert(s->seq >= g_next_seq[s->producer]); /* drops may skip ahead */
+  g_next_seq[s->producer] = s->seq + 1;
+  g_sum += s->value;
+  g_delivered++;
+}
+
+typedef enum { MODE_MUTEX, MODE_SPSC, MODE_DROP } bench_mode_t;
+
+static const char *mode_name[] = {"mutex", "spsc", "drop"};
+
+typedef struct {
+  bench_mode_t mode;
+  uint32_t id;
+  uint32_t count;
+  eb_bus_t *bus;
+  pthread_mutex_t *lock;
+  ebmt_producer_t *out;
+} producer_t;
+
+static void *produce(void *arg) {
+  producer_t *p = (producer_t *)arg;
+  for (uint32_t i = 0; i < p->count; i++) {
+    sample_t s = {p->id, i, (uint64_t)i * 3 + p->id};
+    if (p->mode == MODE_MUTEX) {
+      pthread_mutex_lock(p->lock);
+      eb_post(p->bus, EV_SAMPLE, &s, sizeof(s));
+      pthread_mutex_unlock(p->lock);
+    } else {
+      ebmt_post(p->out, EV_SAMPLE, &s, sizeof(s));
+    }
+  }
+  return NULL;
+}
+
+/* Consumer for the mutex mode */
+typedef struct {
+  eb_bus_t *bus;
+  pthread_mutex_t *lock;
+  atomic_bool done;
+} drainer_t;
+
+static void *drain_locked(void *arg) {
+  drainer_t *d = (drainer_t *)arg;
+  for (;;) {
+    bool last = atomic_load(&d->done); /* read before the final drain */
+    pthread_mutex_lock(d->lock);
+    size_t n = eb_dispatch(d->bus);
+    pthread_mutex_unlock(d->lock);
+    if (last && n == 0)
+      break;
+    if (n == 0)
+      sched_yield();
+  }
+  return NULL;
+}
+
+static void run(bench_mode_t mode, int threads) {
+  eb_bus_t bus;
+  eb_init(&bus);
+  eb_subscribe(&bus, EV_SAMPLE, on_sample, NULL);
+  memset(g_next_seq, 0, sizeof(g_next_seq));
+  g_sum = 0;
+  g_delivered = 0;
+
+  pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+  ebmt_hub_t hub;
+  ebmt_init(&hub, &bus);
+  producer_t prod[MAX_THREADS];
+  uint64_t expect = 0;
+  for (int t = 0; t < threads; t++) {
+    prod[t] = (producer_t){mode, (uint32_t)t, g_events / threads, &bus, &lock,
+                           NULL};
+    if (mode != MODE_MUTEX) {
+      prod[t].out = mode == MODE_DROP
+                        ? ebmt_producer(&hub, 4096, EBMT_DROP)
+                        : ebmt_producer(&hub, 64 * 1024, EBMT_BLOCK);
+      assert(prod[t].out);
+    }
+    for (uint32_t i = 0; i < prod[t].count; i++)
+      expect += (uint64_t)i * 3 + (uint64_t)t;
+  }
+
+  double t0 = now_sec();
+  drainer_t drainer = {&bus, &lock, false};
+  pthread_t consumer, producers[MAX_THREADS];
+  if (mode == MODE_MUTEX)
+    pthread_create(&consumer, NULL, drain_locked, &drainer);
+  else
+    ebmt_start(&hub, -1);
+  for (int t = 0; t < threads; t++)
+    pthread_create(&producers[t], NULL, produce, &prod[t]);
+  for (int t = 0; t < threads; t++)
+    pthread_join(producers[t], NULL);
+  if (mode == MODE_MUTEX) {
+    atomic_store(&drainer.done, true);
+    pthread_join(consumer, NULL);
+  } else {
+    ebmt_stop(&hub);
+  }
+  double secs = now_sec() - t0;
+
+  size_t dropped = 0, stalls = 0;
+  for (int t = 0; t < threads && mode != MODE_MUTEX; t++) {
+    dropped += atomic_load(&prod[t].out->dropped);
+    stalls += atomic_load(&prod[t].out->stalls);
+  }
+  uint64_t posted = (uint64_t)(g_events / threads) * threads;
+  assert(g_delivered + dropped == posted);
+  if (mode != MODE_DROP)
+    assert(g_sum == expect);
+
+  printf("  %-5s %d producer%s %7.1f M events/s", mode_name[mode], threads,
+         threads == 1 ? " " : "s", g_delivered / secs / 1e6);
+  if (mode == MODE_SPSC)
+    printf("   %zu stalls", stalls);
+  if (mode == MODE_DROP)
+    printf("   %.1f%% dropped", 100.0 * (double)dropped / (double)posted);
+  printf("\n");
+
+  ebmt_destroy(&hub);
+  eb_free(&bus);
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1)
+    g_events = atoi(argv[1]);
+  printf("%d events, %ld CPU%s online\n", g_events,
+         sysconf(_SC_NPROCESSORS_ONLN),
+         sysconf(_SC_NPROCESSORS_ONLN) == 1 ? "" : "s");
+  for (int threads = 1; threads <= MAX_THREADS; threads *= 2)
+    for (bench_mode_t m = MODE_MUTEX; m <= MODE_DROP; m++)
+      run(m, threads);
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * ilist.h — Intrusive circular doubly-linked list for C (C99+)
+ *
+ * The links live inside the element, so the list never allocates: embed an
+ * ilist_node in your struct, keep the objects wherever they already live
+ * (an array, a pool, a slot map...) and link them in O(1). Because an
+ * element knows its own neighbours, unlinking it is O(1) too, without the
+ * search-by-value that a node-per-element list needs.
+ *
+ *   typedef struct {
+ *     int id;
+ *     ilist_node link;
+ *   } task;
+ *
+ *   ilist_node ready;
+ *   ilist_init(&ready);
+ *   ilist_push_back(&ready, &t->link);
+ *   ilist_node *it;
+ *   ilist_foreach(it, &ready) {
+ *     task *t = ilist_entry(it, task, link);
+ *   }
+ *   ilist_unlink(&t->link);
+ *
+ * The head is a sentinel node, so there are no NULL checks on insert or
+ * unlink. Prefer deque.h when elements are only added/removed at the ends:
+ * chunks beat pointer chasing for iteration.
+ */
+
+#ifndef ILIST_H
+#define ILIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct ilist_node {
+  struct ilist_node *prev, *next;
+} ilist_node;
+
+/* Containing struct of a node: ilist_entry(ptr, task, link) -> task * */
+#define ilist_entry(ptr, Type, member)                                         \
+  ((Type *)(void *)((char *)(ptr)-offsetof(Type, member)))
+
+/* A list head (or a node that is not on any list) points at itself */
+static inline void ilist_init(ilist_node *n) { n->prev = n->next = n; }
+
+static inline bool ilist_empty(const ilist_node *head) {
+  return head->next == head;
+}
+
+/* Is n on some list? (only valid for nodes that were ilist_init'ed or
+ * unlinked with ilist_unlink) */
+static inline bool ilist_linked(const ilist_node *n) { return n->next != n; }
+
+static inline void ilist__insert(ilist_node *n, ilist_node *prev,
+                                 ilist_node *next) {
+  next->prev = n;
+  n->next = next;
+  n->prev = prev;
+  prev->next = n;
+}
+
+static inline void ilist_push_front(ilist_node *head, ilist_node *n) {
+  ilist__insert(n, head, head->next);
+}
+
+static inline void ilist_push_back(ilist_node *head, ilist_node *n) {
+  ilist__insert(n, head->prev, head);
+}
+
+static inline void ilist_insert_after(ilist_node *pos, ilist_node *n) {
+  ilist__insert(n, pos, pos->next);
+}
+
+static inline void ilist_insert_before(ilist_node *pos, ilist_node *n) {
+  ilist__insert(n, pos->prev, pos);
+}
+
+/* O(1) remove; n is re-initialized so unlinking twice is harmless */
+static inline void ilist_unlink(ilist_node *n) {
+  n->prev->next = n->next;
+  n->next->prev = n->prev;
+  ilist_init(n);
+}
+
+/* First / last node, or NULL if empty */
+static inline ilist_node *ilist_first(const ilist_node *head) {
+  return ilist_empty(head) ? NULL : head->next;
+}
+
+static inline ilist_node *ilist_last(const ilist_node *head) {
+  return ilist_empty(head) ? NULL : head->prev;
+}
+
+static inline ilist_node *ilist_pop_front(ilist_node *head) {
+  ilist_node *n = ilist_first(head);
+  if (n)
+    ilist_unlink(n);
+  return n;
+}
+
+/* Move every node of `from` to the end of `head` in O(1) */
+static inline void ilist_splice_back(ilist_node *head, ilist_node *from) {
+  if (ilist_empty(from))
+    return;
+  from->next->prev = head->prev;
+  head->prev->next = from->next;
+  from->prev->next = head;
+  head->prev = from->prev;
+  ilist_init(from);
+}
+
+#define ilist_foreach(it, head)                                                \
+  for ((it) = (head)->next; (it) != (head); (it) = (it)->next)
+
+/* Safe against unlinking `it` inside the loop body */
+#define ilist_foreach_safe(it, tmp, head)                                      \
+  for ((it) = (head)->next, (tmp) = (it)->next; (it) != (head);               \
+       (it) = (tmp), (tmp) = (it)->next)
+
+#endif /* ILIST_H */
@@ -1,18 +1,45 @@
 #ifndef KVSTORE_H
 #define KVSTORE_H
 
+#include "arena.h"
+
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/* Optional: custom allocators (see memtrack.h) */
+#ifndef KVSTORE_CALLOC
+#define KVSTORE_CALLOC calloc
+#endif
+
+/* Default is a plain malloc copy: strdup is POSIX, and under -std=c11 it
+ * is only declared when the includer asked for it */
+#ifndef KVSTORE_STRDUP
+#define KVSTORE_STRDUP kvstore__libc_strdup
+static inline char *kvstore__libc_strdup(const char *s) {
+  size_t n = strlen(s) + 1;
+  char *p = (char *)malloc(n);
+  if (p)
+    memcpy(p, s, n);
+  return p;
+}
+#endif
+
+#ifndef KVSTORE_FREE
+#define KVSTORE_FREE free
+#endif
+
 /* ==================== KVStore ====================
    Simple, fast, in-memory key-value store (string → string)
    - Hash table with open addressing + linear probing
    - Automatic resizing
    - Zero dependencies
    - Thread-unsafe (add your own mutex if needed)
+   - Optional arena mode (kvstore_create_arena): keys and values are
+     bump-allocated from a chained arena instead of one strdup each;
+     memory is reclaimed by kvstore_clear / kvstore_destroy
    Usage:
        kvstore_t *kv = kvstore_create();
        kvstore_set(kv, "name", "Alice");
@@ -32,6 +59,8 @@ typedef struct {
   kvstore_entry_t *entries;
   size_t capacity;
   size_t size;
+  bool use_arena;
+  arena_t strings; /* string storage in arena mode */
 } kvstore_t;
 
 /* Internal helpers */
@@ -45,30 +74,65 @@ static inline uint32_t kvstore_hash(const char *str) {
 
 static bool kvstore_resize(kvstore_t *kv, size_t new_capacity);
 
+static inline char *kvstore__strdup(kvstore_t *kv, const char *s) {
+  return kv->use_arena ? arena_strdup(&kv->strings, s) : KVSTORE_STRDUP(s);
+}
+
+static inline void kvstore__strfree(kvstore_t *kv, char *s) {
+  if (!kv->use_arena)
+    KVSTORE_FREE(s); /* arena strings die with kvstore_clear / kvstore_destroy */
+}
+
+/* Place an already-owned entry into the first free slot of its probe run */
+static inline void kvstore__place(kvstore_t *kv, kvstore_entry_t entry) {
+  size_t index = (size_t)(entry.hash & (kv->capacity - 1));
+  while (kv->entries[index].key)
+    index = (index + 1) & (kv->capacity - 1);
+  kv->entries[index] = entry;
+  kv->size++;
+}
+
 /* Public API */
 
 static inline kvstore_t *kvstore_create(void) {
-  kvstore_t *kv = calloc(1, sizeof(kvstore_t));
+  kvstore_t *kv = KVSTORE_CALLOC(1, sizeof(kvstore_t));
   if (!kv)
     return NULL;
   kv->capacity = 16;
-  kv->entries = calloc(kv->capacity, sizeof(kvstore_entry_t));
+  kv->entries = KVSTORE_CALLOC(kv->capacity, sizeof(kvstore_entry_t));
   if (!kv->entries) {
-    free(kv);
+    KVSTORE_FREE(kv);
     return NULL;
   }
   return kv;
 }
 
+/* Same as kvstore_create, but strings live in an arena (block_size 0 picks
+ * ARENA_DEFAULT_BLOCK). Best for many small strings that are cleared
+ * together; overwritten or deleted strings are only reclaimed by
+ * kvstore_clear. */
+static inline kvstore_t *kvstore_create_arena(size_t block_size) {
+  kvstore_t *kv = kvstore_create();
+  if (!kv)
+    return NULL;
+  kv->use_arena = true;
+  arena_init(&kv->strings, block_size);
+  return kv;
+}
+
 static inline void kvstore_destroy(kvstore_t *kv) {
   if (!kv)
     return;
-  for (size_t i = 0; i < kv->capacity; ++i) {
-    free(kv->entries[i].key);
-    free(kv->entries[i].value);
+  if (kv->use_arena) {
+    arena_free(&kv->strings);
+  } else {
+    for (size_t i = 0; i < kv->capacity; ++i) {
+      KVSTORE_FREE(kv->entries[i].key);
+      KVSTORE_FREE(kv->entries[i].value);
+    }
   }
-  free(kv->entries);
-  free(kv);
+  KVSTORE_FREE(kv->entries);
+  KVSTORE_FREE(kv);
 }
 
 static inline size_t kvstore_size(const kvstore_t *kv) {
@@ -80,12 +144,14 @@ static inline void kvstore_clear(kvstore_t *kv) {
     return;
   for (size_t i = 0; i < kv->capacity; ++i) {
     if (kv->entries[i].key) {
-      free(kv->entries[i].key);
-      free(kv->entries[i].value);
+      kvstore__strfree(kv, kv->entries[i].key);
+      kvstore__strfree(kv, kv->entries[i].value);
       kv->entries[i].key = NULL;
       kv->entries[i].value = NULL;
     }
   }
+  if (kv->use_arena)
+    arena_reset(&kv->strings);
   kv->size = 0;
 }
 
@@ -102,10 +168,15 @@ static inline bool kvstore_set(kvstore_t *kv, const char *key,
   for (size_t i = 0; i < kv->capacity; ++i) {
     kvstore_entry_t *entry = &kv->entries[index];
     if (entry->key && entry->hash == hash && strcmp(entry->key, key) == 0) {
-      char *new_val = strdup(value);
+      size_t len = strlen(value);
+      if (kv->use_arena && len <= strlen(entry->value)) {
+        memcpy(entry->value, value, len + 1); /* reuse arena storage */
+        return true;
+      }
+      char *new_val = kvstore__strdup(kv, value);
       if (!new_val)
         return false;
-      free(entry->value);
+      kvstore__strfree(kv, entry->value);
       entry->value = new_val;
       return true; /* overwritten */
     }
@@ -128,12 +199,12 @@ static inline bool kvstore_set(kvstore_t *kv, const char *key,
   }
 
   kvstore_entry_t *entry = &kv->entries[index];
-  entry->key = strdup(key);
-  entry->value = strdup(value);
+  entry->key = kvstore__strdup(kv, key);
+  entry->value = kvstore__strdup(kv, value);
   entry->hash = hash;
   if (!entry->key || !entry->value) {
-    free(entry->key);
-    free(entry->value);
+    kvstore__strfree(kv, entry->key);
+    kvstore__strfree(kv, entry->value);
     entry->key = entry->value = NULL;
     return false;
   }
@@ -174,8 +245,8 @@ static inline bool kvstore_del(kvstore_t *kv, const char *key) {
     if (!entry->key)
       return false;
     if (entry->hash == hash && strcmp(entry->key, key) == 0) {
-      free(entry->key);
-      free(entry->value);
+      kvstore__strfree(kv, entry->key);
+      kvstore__strfree(kv, entry->value);
       entry->key = entry->value = NULL;
 
       /* Rehash all following entries (linear probing needs this) */
@@ -184,9 +255,7 @@ static inline bool kvstore_del(kvstore_t *kv, const char *key) {
         kvstore_entry_t tmp = kv->entries[next];
         kv->entries[next] = (kvstore_entry_t){0};
         kv->size--;
-        kvstore_set(kv, tmp.key, tmp.value); /* will re-insert correctly */
-        free(tmp.key);
-        free(tmp.value);
+        kvstore__place(kv, tmp); /* re-insert, keeping its strings */
         next = (next + 1) & (kv->capacity - 1);
       }
       kv->size--;
@@ -234,7 +303,7 @@ static bool kvstore_resize(kvstore_t *kv, size_t new_capacity) {
 
   kv->capacity = new_capacity;
   kv->size = 0;
-  kv->entries = calloc(kv->capacity, sizeof(kvstore_entry_t));
+  kv->entries = KVSTORE_CALLOC(kv->capacity, sizeof(kvstore_entry_t));
   if (!kv->entries) {
     kv->entries = old_entries;
     kv->capacity = old_capacity;
@@ -242,13 +311,10 @@ static bool kvstore_resize(kvstore_t *kv, size_t new_capacity) {
   }
 
   for (size_t i = 0; i < old_capacity; ++i) {
-    if (old_entries[i].key) {
-      kvstore_set(kv, old_entries[i].key, old_entries[i].value);
-      free(old_entries[i].key);
-      free(old_entries[i].value);
-    }
+    if (old_entries[i].key)
+      kvstore__place(kv, old_entries[i]);
   }
-  free(old_entries);
+  KVSTORE_FREE(old_entries);
   return true;
 }
 
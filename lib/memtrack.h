@@ -0,0 +1,410 @@
+/*
+ * memtrack.h — Opt-in allocation tracking / heap profiling for lib/ (C11)
+ *
+ * Build with -DMEMTRACK and include this header BEFORE any container
+ * header. Every container allocation is then routed through a tracker that
+ * records, per tag (container) and per call site:
+ *   allocations, frees, live bytes, peak live bytes, total bytes allocated
+ *
+ * At exit a report sorted by peak bytes goes to stderr, and if the
+ * MEMTRACK_FOLDED environment variable names a file, a folded-stack file
+ * ("tag;file:line peak_bytes" per line) is written there for flamegraph.pl
+ * or speedscope. Set MEMTRACK_QUIET=1 to skip the stderr report.
+ *
+ * Without -DMEMTRACK nothing here is compiled in: the container hooks keep
+ * their libc defaults and mt_malloc & co. are plain malloc & co.
+ *
+ * Tags used by the lib/ containers: dynarray, kvstore, strbuilder (also
+ * str_builder.h), arena, ringbuf, pool. Application code can use mt_malloc /
+ * mt_free (tag MEMTRACK_DEFAULT_TAG) or the *_tag variants.
+ *
+ * Sizes are kept in a side table keyed by pointer rather than in a block
+ * header, so a tracked pointer released with plain free() (for example a
+ * string taken out of strbuilder_build) is still safe; it just stays
+ * "live" in the report. The tracker state is per translation unit, like
+ * every other static-inline header here.
+ */
+
+#ifndef MEMTRACK_H
+#define MEMTRACK_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef MEMTRACK_DEFAULT_TAG
+#define MEMTRACK_DEFAULT_TAG "app"
+#endif
+
+#ifdef MEMTRACK
+
+#include <stdatomic.h>
+#include <stdio.h>
+
+#ifndef MEMTRACK_MAX_SITES
+#define MEMTRACK_MAX_SITES 512
+#endif
+
+typedef struct {
+  const char *tag;
+  const char *file; /* NULL for the per-tag summary rows */
+  int line;
+  size_t allocs, frees;
+  size_t live, peak, total;
+} memtrack_site_t;
+
+typedef struct {
+  uintptr_t ptr; /* 0 = empty slot */
+  size_t size;
+  unsigned site, tag_site;
+} memtrack_entry_t;
+
+static struct {
+  atomic_flag lock;
+  int at_exit_registered;
+  memtrack_site_t sites[MEMTRACK_MAX_SITES];
+  unsigned site_count;
+  memtrack_entry_t *table; /* live pointers, open addressing */
+  size_t table_cap, table_count;
+  size_t live, peak;
+} memtrack__g = {.lock = ATOMIC_FLAG_INIT};
+
+static void memtrack_report(FILE *out);
+static int memtrack_write_folded(const char *path);
+
+static inline void memtrack__lock(void) {
+  while (atomic_flag_test_and_set_explicit(&memtrack__g.lock,
+                                           memory_order_acquire)) {
+  }
+}
+
+static inline void memtrack__unlock(void) {
+  atomic_flag_clear_explicit(&memtrack__g.lock, memory_order_release);
+}
+
+static void memtrack__at_exit(void) {
+  const char *quiet = getenv("MEMTRACK_QUIET");
+  if (!quiet || !*quiet || *quiet == '0')
+    memtrack_report(stderr);
+  const char *folded = getenv("MEMTRACK_FOLDED");
+  if (folded && *folded)
+    memtrack_write_folded(folded);
+}
+
+/* Site lookup: tags and files are string literals, so compare pointers */
+static unsigned memtrack__site(const char *tag, const char *file, int line) {
+  for (unsigned i = 0; i < memtrack__g.site_count; i++) {
+    memtrack_site_t *s = &memtrack__g.sites[i];
+    if (s->line == line && s->file == file && s->tag == tag)
+      return i;
+  }
+  if (memtrack__g.site_count == MEMTRACK_MAX_SITES)
+    return MEMTRACK_MAX_SITES - 1; /* overflow bucket */
+  memtrack_site_t *s = &memtrack__g.sites[memtrack__g.site_count];
+  memset(s, 0, sizeof *s);
+  s->tag = tag;
+  s->file = file;
+  s->line = line;
+  if (memtrack__g.site_count == MEMTRACK_MAX_SITES - 1) {
+    s->tag = "(overflow)";
+    s->file = "(sites)";
+  }
+  return memtrack__g.site_count++;
+}
+
+static inline size_t memtrack__slot(uintptr_t p, size_t cap) {
+  return (size_t)((p >> 4) * 0x9E3779B97F4A7C15ull) & (cap - 1);
+}
+
+static void memtrack__table_insert(memtrack_entry_t e) {
+  if ((memtrack__g.table_count + 1) * 2 > memtrack__g.table_cap) {
+    size_t old_cap = memtrack__g.table_cap;
+    memtrack_entry_t *old = memtrack__g.table;
+    size_t cap = old_cap ? old_cap * 2 : 1024;
+    memtrack_entry_t *t = (memtrack_entry_t *)calloc(cap, sizeof *t);
+    if (!t)
+      return; /* untracked from here on; frees are ignored */
+    for (size_t i = 0; i < old_cap; i++) {
+      if (!old[i].ptr)
+        continue;
+      size_t j = memtrack__slot(old[i].ptr, cap);
+      while (t[j].ptr)
+        j = (j + 1) & (cap - 1);
+      t[j] = old[i];
+    }
+    free(old);
+    memtrack__g.table = t;
+    memtrack__g.table_cap = cap;
+  }
+  size_t j = memtrack__slot(e.ptr, memtrack__g.table_cap);
+  while (memtrack__g.table[j].ptr)
+    j = (j + 1) & (memtrack__g.table_cap - 1);
+  memtrack__g.table[j] = e;
+  memtrack__g.table_count++;
+}
+
+/* Remove and return the entry for p; returns 0 if p is not tracked */
+static int memtrack__table_take(uintptr_t p, memtrack_entry_t *out) {
+  size_t cap = memtrack__g.table_cap;
+  if (!cap)
+    return 0;
+  size_t i = memtrack__slot(p, cap);
+  while (memtrack__g.table[i].ptr && memtrack__g.table[i].ptr != p)
+    i = (i + 1) & (cap - 1);
+  if (!memtrack__g.table[i].ptr)
+    return 0;
+  *out = memtrack__g.table[i];
+  /* Backward-shift deletion keeps probe runs intact without tombstones */
+  size_t j = i;
+  for (;;) {
+    memtrack__g.table[i].ptr = 0;
+    for (;;) {
+      j = (j + 1) & (cap - 1);
+      if (!memtrack__g.table[j].ptr) {
+        memtrack__g.table_count--;
+        return 1;
+      }
+      size_t home = memtrack__slot(memtrack__g.table[j].ptr, cap);
+      if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+        continue;
+      break;
+    }
+    memtrack__g.table[i] = memtrack__g.table[j];
+    i = j;
+  }
+}
+
+static void memtrack__account_alloc(void *p, size_t size, const char *tag,
+                                    const char *file, int line) {
+  memtrack__lock();
+  if (!memtrack__g.at_exit_registered) {
+    memtrack__g.at_exit_registered = 1;
+    atexit(memtrack__at_exit);
+  }
+  unsigned site = memtrack__site(tag, file, line);
+  unsigned tag_site = memtrack__site(tag, NULL, 0);
+  memtrack_site_t *rows[2] = {&memtrack__g.sites[site],
+                              &memtrack__g.sites[tag_site]};
+  for (int r = 0; r < 2; r++) {
+    rows[r]->allocs++;
+    rows[r]->total += size;
+    rows[r]->live += size;
+    if (rows[r]->live > rows[r]->peak)
+      rows[r]->peak = rows[r]->live;
+  }
+  memtrack__g.live += size;
+  if (memtrack__g.live > memtrack__g.peak)
+    memtrack__g.peak = memtrack__g.live;
+  memtrack_entry_t e = {(uintptr_t)p, size, site, tag_site};
+  memtrack__table_insert(e);
+  memtrack__unlock();
+}
+
+/* Unregisters p and takes its size back out of the counters; returns 0
+ * if p is not tracked. *out can be handed to memtrack__account_restore. */
+static int memtrack__account_take(uintptr_t p, memtrack_entry_t *out) {
+  memtrack__lock();
+  int found = memtrack__table_take(p, out);
+  if (found) {
+    memtrack__g.sites[out->site].frees++;
+    memtrack__g.sites[out->site].live -= out->size;
+    memtrack__g.sites[out->tag_site].frees++;
+    memtrack__g.sites[out->tag_site].live -= out->size;
+    memtrack__g.live -= out->size;
+  }
+  memtrack__unlock();
+  return found;
+}
+
+/* Undoes memtrack__account_take for a block that turned out to survive */
+static void memtrack__account_restore(memtrack_entry_t e) {
+  memtrack__lock();
+  memtrack__g.sites[e.site].frees--;
+  memtrack__g.sites[e.site].live += e.size;
+  memtrack__g.sites[e.tag_site].frees--;
+  memtrack__g.sites[e.tag_site].live += e.size;
+  memtrack__g.live += e.size;
+  memtrack__table_insert(e);
+  memtrack__unlock();
+}
+
+static void memtrack__account_free(uintptr_t p) {
+  memtrack_entry_t e;
+  memtrack__account_take(p, &e);
+}
+
+/* ========================= tracked allocators ========================= */
+
+static inline void *memtrack_malloc(size_t size, const char *tag,
+                                    const char *file, int line) {
+  void *p = malloc(size);
+  if (p)
+    memtrack__account_alloc(p, size, tag, file, line);
+  return p;
+}
+
+static inline void *memtrack_calloc(size_t n, size_t size, const char *tag,
+                                    const char *file, int line) {
+  void *p = calloc(n, size);
+  if (p)
+    memtrack__account_alloc(p, n * size, tag, file, line);
+  return p;
+}
+
+/* The old block is unregistered before realloc: once realloc frees it,
+ * another thread's malloc may get the same address and register it, and
+ * taking old's entry after that would take theirs. */
+static inline void *memtrack_realloc(void *old, size_t size, const char *tag,
+                                     const char *file, int line) {
+  memtrack_entry_t e;
+  int tracked = old && memtrack__account_take((uintptr_t)old, &e);
+  void *p = realloc(old, size);
+  if (!p && size) {
+    if (tracked)
+      memtrack__account_restore(e); /* old block untouched */
+    return NULL;
+  }
+  if (p)
+    memtrack__account_alloc(p, size, tag, file, line);
+  return p;
+}
+
+static inline void memtrack_free(void *p) {
+  if (!p)
+    return;
+  memtrack__account_free((uintptr_t)p);
+  free(p);
+}
+
+static inline char *memtrack_strdup(const char *s, const char *tag,
+                                    const char *file, int line) {
+  size_t n = strlen(s) + 1;
+  char *p = (char *)memtrack_malloc(n, tag, file, line);
+  if (p)
+    memcpy(p, s, n);
+  return p;
+}
+
+/* ========================= reporting ========================= */
+
+static int memtrack__by_peak(const void *a, const void *b) {
+  const memtrack_site_t *x = (const memtrack_site_t *)a;
+  const memtrack_site_t *y = (const memtrack_site_t *)b;
+  return x->peak < y->peak ? 1 : x->peak > y->peak ? -1 : 0;
+}
+
+/* Copy of the site table, sorted by peak bytes (caller frees) */
+static memtrack_site_t *memtrack__sorted(unsigned *count) {
+  memtrack__lock();
+  *count = memtrack__g.site_count;
+  memtrack_site_t *rows =
+      (memtrack_site_t *)malloc((*count ? *count : 1) * sizeof *rows);
+  if (rows)
+    memcpy(rows, memtrack__g.sites, *count * sizeof *rows);
+  memtrack__unlock();
+  if (rows)
+    qsort(rows, *count, sizeof *rows, memtrack__by_peak);
+  return rows;
+}
+
+static void memtrack_report(FILE *out) {
+  unsigned n;
+  memtrack_site_t *rows = memtrack__sorted(&n);
+  if (!rows)
+    return;
+  fprintf(out, "\n==== memtrack: peak %zu bytes, live %zu bytes ====\n",
+          memtrack__g.peak, memtrack__g.live);
+  for (int pass = 0; pass < 2; pass++) {
+    fprintf(out, "\n%-12s %-32s %10s %10s %12s %12s %14s\n",
+            pass ? "tag" : "tag (total)", pass ? "site" : "",
+            "allocs", "frees", "live", "peak", "total");
+    for (unsigned i = 0; i < n; i++) {
+      const memtrack_site_t *s = &rows[i];
+      if ((s->file == NULL) == (pass == 1))
+        continue;
+      char site[64] = "";
+      if (s->file) {
+        const char *base = strrchr(s->file, '/');
+        snprintf(site, sizeof site, "%s:%d", base ? base + 1 : s->file,
+                 s->line);
+      }
+      fprintf(out, "%-12s %-32s %10zu %10zu %12zu %12zu %14zu\n", s->tag,
+              site, s->allocs, s->frees, s->live, s->peak, s->total);
+    }
+  }
+  free(rows);
+}
+
+/* "tag;file:line peak_bytes" lines, for flamegraph.pl / speedscope */
+static int memtrack_write_folded(const char *path) {
+  FILE *f = fopen(path, "w");
+  if (!f)
+    return 0;
+  unsigned n;
+  memtrack_site_t *rows = memtrack__sorted(&n);
+  for (unsigned i = 0; rows && i < n; i++) {
+    if (rows[i].file && rows[i].peak)
+      fprintf(f, "%s;%s:%d %zu\n", rows[i].tag, rows[i].file, rows[i].line,
+              rows[i].peak);
+  }
+  free(rows);
+  fclose(f);
+  return 1;
+}
+
+#define mt_malloc_tag(tag, n) memtrack_malloc((n), (tag), __FILE__, __LINE__)
+#define mt_calloc_tag(tag, n, sz)                                              \
+  memtrack_calloc((n), (sz), (tag), __FILE__, __LINE__)
+#define mt_realloc_tag(tag, p, n)                                              \
+  memtrack_realloc((p), (n), (tag), __FILE__, __LINE__)
+#define mt_strdup_tag(tag, s) memtrack_strdup((s), (tag), __FILE__, __LINE__)
+#define mt_free(p) memtrack_free(p)
+
+/* ========================= container hooks ========================= */
+
+#define DA_MALLOC(n) mt_malloc_tag("dynarray", n)
+#define DA_REALLOC(p, n) mt_realloc_tag("dynarray", p, n)
+#define DA_FREE(p) mt_free(p)
+
+#define KVSTORE_CALLOC(n, sz) mt_calloc_tag("kvstore", n, sz)
+#define KVSTORE_STRDUP(s) mt_strdup_tag("kvstore", s)
+#define KVSTORE_FREE(p) mt_free(p)
+
+#define STRBUILDER_MALLOC(n) mt_malloc_tag("strbuilder", n)
+#define STRBUILDER_REALLOC(p, n) mt_realloc_tag("strbuilder", p, n)
+#define STRBUILDER_FREE(p) mt_free(p)
+
+#define ARENA_MALLOC(n) mt_malloc_tag("arena", n)
+#define ARENA_FREE(p) mt_free(p)
+
+#define RB_MALLOC(n) mt_malloc_tag("ringbuf", n)
+#define RB_FREE(p) mt_free(p)
+
+#define POOL_MALLOC(n) mt_malloc_tag("pool", n)
+#define POOL_FREE(p) mt_free(p)
+
+#else /* !MEMTRACK: compiled out, plain libc */
+
+/* strdup is POSIX, and under -std=c11 only declared on request */
+static inline char *memtrack__libc_strdup(const char *s) {
+  size_t n = strlen(s) + 1;
+  char *p = (char *)malloc(n);
+  if (p)
+    memcpy(p, s, n);
+  return p;
+}
+
+#define mt_malloc_tag(tag, n) malloc(n)
+#define mt_calloc_tag(tag, n, sz) calloc((n), (sz))
+#define mt_realloc_tag(tag, p, n) realloc((p), (n))
+#define mt_strdup_tag(tag, s) memtrack__libc_strdup(s)
+#define mt_free(p) free(p)
+
+#endif /* MEMTRACK */
+
+#define mt_malloc(n) mt_malloc_tag(MEMTRACK_DEFAULT_TAG, n)
+#define mt_calloc(n, sz) mt_calloc_tag(MEMTRACK_DEFAULT_TAG, n, sz)
+#define mt_realloc(p, n) mt_realloc_tag(MEMTRACK_DEFAULT_TAG, p, n)
+#define mt_strdup(s) mt_strdup_tag(MEMTRACK_DEFAULT_TAG, s)
+
+#endif /* MEMTRACK_H */
@@ -0,0 +1,218 @@
+/*
+ * metrics.h — Sharded, contention-free counters / gauges / histograms (C11)
+ *
+ * Every metric is split into METRICS_SHARDS cache-line sized slots. A thread
+ * only ever touches "its" slot with a relaxed atomic add, so concurrent
+ * increments from many cores do not bounce a shared cache line or take a
+ * lock. Reads walk all slots and sum them; they are not a point-in-time
+ * snapshot under concurrent writes, but every completed add is counted.
+ *
+ * Shard selection:
+ *   default            — each thread gets a round-robin slot on first use
+ *   METRICS_SHARD_BY_CPU — use sched_getcpu() (Linux), good when threads
+ *                          migrate rarely and outnumber the shards; needs
+ *                          _GNU_SOURCE defined before any system header
+ *
+ * Example:
+ *   static metric_counter_t requests;        // zero-initialized is valid
+ *   metric_counter_inc(&requests);
+ *   printf("%lld\n", metric_counter_read(&requests));
+ *
+ * Compile with -pthread when used from multiple threads.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <limits.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef METRICS_SHARD_BY_CPU
+#include <sched.h>
+#if defined(__GLIBC__) && !defined(__USE_GNU)
+#error "METRICS_SHARD_BY_CPU: define _GNU_SOURCE before any system header"
+#endif
+#endif
+
+/* Configuration */
+#ifndef METRICS_CACHE_LINE
+#define METRICS_CACHE_LINE 64
+#endif
+
+/* Must be a power of two */
+#ifndef METRICS_SHARDS
+#define METRICS_SHARDS 64
+#endif
+
+/* Histogram buckets: bucket b counts values v with floor(log2(v)) == b - 1,
+ * bucket 0 counts zero. 64 buckets cover the whole uint64_t range. */
+#define METRICS_HIST_BUCKETS 65
+
+/* ========================= shard selection ========================= */
+
+static atomic_uint metrics__next_shard;
+static _Thread_local unsigned metrics__shard = UINT_MAX;
+
+static inline unsigned metrics__shard_index(void) {
+#ifdef METRICS_SHARD_BY_CPU
+  int cpu = sched_getcpu();
+  if (cpu >= 0)
+    return (unsigned)cpu & (METRICS_SHARDS - 1);
+#endif
+  if (metrics__shard == UINT_MAX)
+    metrics__shard = atomic_fetch_add_explicit(&metrics__next_shard, 1,
+                                               memory_order_relaxed) &
+                     (METRICS_SHARDS - 1);
+  return metrics__shard;
+}
+
+/* ========================= counter ========================= */
+
+typedef struct {
+  alignas(METRICS_CACHE_LINE) atomic_llong value;
+} metric_slot_t;
+
+typedef struct {
+  metric_slot_t slots[METRICS_SHARDS];
+} metric_counter_t;
+
+static inline void metric_counter_init(metric_counter_t *c) {
+  for (int i = 0; i < METRICS_SHARDS; i++)
+    atomic_init(&c->slots[i].value, 0);
+}
+
+/* Heap helpers: metric types are over-aligned, plain malloc is not enough */
+static inline metric_counter_t *metric_counter_create(void) {
+  metric_counter_t *c = (metric_counter_t *)aligned_alloc(
+      METRICS_CACHE_LINE, sizeof(metric_counter_t));
+  if (c)
+    metric_counter_init(c);
+  return c;
+}
+
+static inline void metric_counter_destroy(metric_counter_t *c) { free(c); }
+
+static inline void metric_counter_add(metric_counter_t *c, long long n) {
+  atomic_fetch_add_explicit(&c->slots[metrics__shard_index()].value, n,
+                            memory_order_relaxed);
+}
+
+static inline void metric_counter_inc(metric_counter_t *c) {
+  metric_counter_add(c, 1);
+}
+
+static inline long long metric_counter_read(metric_counter_t *c) {
+  long long sum = 0;
+  for (int i = 0; i < METRICS_SHARDS; i++)
+    sum += atomic_load_explicit(&c->slots[i].value, memory_order_relaxed);
+  return sum;
+}
+
+/* Not atomic with respect to concurrent adds */
+static inline void metric_counter_reset(metric_counter_t *c) {
+  for (int i = 0; i < METRICS_SHARDS; i++)
+    atomic_store_explicit(&c->slots[i].value, 0, memory_order_relaxed);
+}
+
+/* ========================= gauge ========================= */
+
+/* A gauge is an up/down counter (in-flight requests, queue depth, bytes in
+ * use). Each shard holds a signed delta; the sum is the current level. */
+typedef metric_counter_t metric_gauge_t;
+
+#define metric_gauge_init(g) metric_counter_init(g)
+#define metric_gauge_create() metric_counter_create()
+#define metric_gauge_destroy(g) metric_counter_destroy(g)
+#define metric_gauge_add(g, n) metric_counter_add((g), (n))
+#define metric_gauge_sub(g, n) metric_counter_add((g), -(long long)(n))
+#define metric_gauge_read(g) metric_counter_read(g)
+
+/* ========================= histogram ========================= */
+
+typedef struct {
+  alignas(METRICS_CACHE_LINE) atomic_ullong buckets[METRICS_HIST_BUCKETS];
+  atomic_ullong sum;
+} metric_hist_shard_t;
+
+typedef struct {
+  metric_hist_shard_t shards[METRICS_SHARDS];
+} metric_hist_t;
+
+/* Aggregated, non-atomic copy for reporting */
+typedef struct {
+  unsigned long long buckets[METRICS_HIST_BUCKETS];
+  unsigned long long count;
+  unsigned long long sum;
+} metric_hist_snapshot_t;
+
+static inline void metric_hist_init(metric_hist_t *h) {
+  for (int s = 0; s < METRICS_SHARDS; s++) {
+    for (int b = 0; b < METRICS_HIST_BUCKETS; b++)
+      atomic_init(&h->shards[s].buckets[b], 0);
+    atomic_init(&h->shards[s].sum, 0);
+  }
+}
+
+static inline metric_hist_t *metric_hist_create(void) {
+  metric_hist_t *h =
+      (metric_hist_t *)aligned_alloc(METRICS_CACHE_LINE, sizeof(metric_hist_t));
+  if (h)
+    metric_hist_init(h);
+  return h;
+}
+
+static inline void metric_hist_destroy(metric_hist_t *h) { free(h); }
+
+static inline int metric_hist_bucket(uint64_t v) {
+  return v ? 64 - __builtin_clzll(v) : 0;
+}
+
+/* Upper bound (inclusive) of the values counted in bucket b */
+static inline uint64_t metric_hist_bucket_max(int b) {
+  return b == 0 ? 0 : b >= 64 ? UINT64_MAX : (UINT64_C(1) << b) - 1;
+}
+
+static inline void metric_hist_record(metric_hist_t *h, uint64_t v) {
+  metric_hist_shard_t *s = &h->shards[metrics__shard_index()];
+  atomic_fetch_add_explicit(&s->buckets[metric_hist_bucket(v)], 1,
+                            memory_order_relaxed);
+  atomic_fetch_add_explicit(&s->sum, v, memory_order_relaxed);
+}
+
+static inline void metric_hist_snapshot(metric_hist_t *h,
+                                        metric_hist_snapshot_t *out) {
+  memset(out, 0, sizeof *out);
+  for (int s = 0; s < METRICS_SHARDS; s++) {
+    for (int b = 0; b < METRICS_HIST_BUCKETS; b++) {
+      unsigned long long n = atomic_load_explicit(&h->shards[s].buckets[b],
+                                                  memory_order_relaxed);
+      out->buckets[b] += n;
+      out->count += n;
+    }
+    out->sum += atomic_load_explicit(&h->shards[s].sum, memory_order_relaxed);
+  }
+}
+
+/* Bucket upper bound at quantile q (0..1); an over-estimate of at most 2x */
+static inline uint64_t metric_hist_quantile(const metric_hist_snapshot_t *snap,
+                                            double q) {
+  if (!snap->count)
+    return 0;
+  unsigned long long rank = (unsigned long long)(q * (double)snap->count);
+  if (rank >= snap->count)
+    rank = snap->count - 1;
+  unsigned long long seen = 0;
+  for (int b = 0; b < METRICS_HIST_BUCKETS; b++) {
+    seen += snap->buckets[b];
+    if (seen > rank)
+      return metric_hist_bucket_max(b);
+  }
+  return UINT64_MAX;
+}
+
+#endif /* METRICS_H */
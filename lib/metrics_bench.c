@@ -0,0 +1,122 @@
+/*
+ * metrics_bench.c — scaling benchmark for metrics.h counters
+ *
+ * Compares three ways of counting events from 1..64 threads:
+ *   mutex   — pthread_mutex around a long (the old ThreadSafeCounter)
+ *   atomic  — one shared atomic_long, relaxed fetch_add
+ *   sharded — metric_counter_t (per-thread cache-line slots)
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 -pthread metrics_bench.c -o metrics_bench
+ *
+ * Run:
+ *   ./metrics_bench [increments_per_thread]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "metrics.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_THREADS 64
+
+typedef enum { MODE_MUTEX, MODE_ATOMIC, MODE_SHARDED } bench_mode;
+
+static const char *mode_names[] = {"mutex", "atomic", "sharded"};
+
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+static long g_locked_count;
+static atomic_long g_atomic_count;
+static metric_counter_t g_sharded;
+
+static long g_iters = 2000000;
+static bench_mode g_mode;
+static pthread_barrier_t g_start;
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void *worker(void *arg) {
+  (void)arg;
+  pthread_barrier_wait(&g_start);
+  switch (g_mode) {
+  case MODE_MUTEX:
+    for (long i = 0; i < g_iters; i++) {
+      pthread_mutex_lock(&g_mutex);
+      g_locked_count++;
+      pthread_mutex_unlock(&g_mutex);
+    }
+    break;
+  case MODE_ATOMIC:
+    for (long i = 0; i < g_iters; i++)
+      atomic_fetch_add_explicit(&g_atomic_count, 1, memory_order_relaxed);
+    break;
+  case MODE_SHARDED:
+    for (long i = 0; i < g_iters; i++)
+      metric_counter_inc(&g_sharded);
+    break;
+  }
+  return NULL;
+}
+
+static long long read_total(void) {
+  switch (g_mode) {
+  case MODE_MUTEX:
+    return g_locked_count;
+  case MODE_ATOMIC:
+    return atomic_load(&g_atomic_count);
+  case MODE_SHARDED:
+    return metric_counter_read(&g_sharded);
+  }
+  return 0;
+}
+
+static double run(bench_mode mode, int nthreads) {
+  pthread_t threads[MAX_THREADS];
+  g_mode = mode;
+  g_locked_count = 0;
+  atomic_store(&g_atomic_count, 0);
+  metric_counter_reset(&g_sharded);
+  pthread_barrier_init(&g_start, NULL, nthreads + 1);
+
+  for (int i = 0; i < nthreads; i++)
+    pthread_create(&threads[i], NULL, worker, NULL);
+
+  double t0 = now_sec();
+  pthread_barrier_wait(&g_start);
+  for (int i = 0; i < nthreads; i++)
+    pthread_join(threads[i], NULL);
+  double elapsed = now_sec() - t0;
+  pthread_barrier_destroy(&g_start);
+
+  long long expected = (long long)nthreads * g_iters;
+  if (read_total() != expected) {
+    fprintf(stderr, "%s: lost updates (%lld != %lld)\n", mode_names[mode],
+            read_total(), expected);
+    exit(1);
+  }
+  return expected / elapsed / 1e6;
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1)
+    g_iters = atol(argv[1]);
+  metric_counter_init(&g_sharded);
+
+  printf("%ld increments per thread, Mops/s (higher is better)\n\n", g_iters);
+  printf("%8s %12s %12s %12s\n", "threads", "mutex", "atomic", "sharded");
+  for (int n = 1; n <= MAX_THREADS; n *= 2) {
+    printf("%8d", n);
+    for (int m = MODE_MUTEX; m <= MODE_SHARDED; m++) {
+      printf(" %12.1f", run((bench_mode)m, n));
+      fflush(stdout);
+    }
+    printf("\n");
+  }
+  return 0;
+}
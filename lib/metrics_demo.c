@@ -0,0 +1,56 @@
+/*
+ * metrics_demo.c — demo for metrics.h
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 -pthread metrics_demo.c -o metrics_demo
+ */
+
+#include "metrics.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+
+#define THREADS 8
+#define PER_THREAD 100000
+
+static metric_counter_t requests;
+static metric_gauge_t in_flight;
+static metric_hist_t latency_us;
+
+static void *worker(void *arg) {
+  unsigned seed = (unsigned)(size_t)arg;
+  for (int i = 0; i < PER_THREAD; i++) {
+    metric_gauge_add(&in_flight, 1);
+    metric_counter_inc(&requests);
+    seed = seed * 1103515245u + 12345u;
+    metric_hist_record(&latency_us, 10 + (seed >> 16) % 1000);
+    metric_gauge_sub(&in_flight, 1);
+  }
+  return NULL;
+}
+
+int main(void) {
+  metric_counter_init(&requests);
+  metric_gauge_init(&in_flight);
+  metric_hist_init(&latency_us);
+
+  pthread_t threads[THREADS];
+  for (int i = 0; i < THREADS; i++)
+    pthread_create(&threads[i], NULL, worker, (void *)(size_t)(i + 1));
+  for (int i = 0; i < THREADS; i++)
+    pthread_join(threads[i], NULL);
+
+  printf("requests  = %lld\n", metric_counter_read(&requests)); // 800000
+  printf("in flight = %lld\n", metric_gauge_read(&in_flight));  // 0
+  assert(metric_counter_read(&requests) == THREADS * PER_THREAD);
+  assert(metric_gauge_read(&in_flight) == 0);
+
+  metric_hist_snapshot_t snap;
+  metric_hist_snapshot(&latency_us, &snap);
+  assert(snap.count == THREADS * PER_THREAD);
+  printf("latency mean = %.1f us\n", (double)snap.sum / snap.count);
+  printf("latency p50 <= %llu us, p99 <= %llu us\n",
+         (unsigned long long)metric_hist_quantile(&snap, 0.50),
+         (unsigned long long)metric_hist_quantile(&snap, 0.99));
+  return 0;
+}
@@ -0,0 +1,319 @@
+/*
+ * numfmt.h — Fast integer / double to decimal text, no printf (C99+)
+ *
+ *   char buf[NUMFMT_MAX];
+ *   size_t n = numfmt_u64(buf, 18446744073709551615u); // "18446744..."
+ *   n = numfmt_f64(buf, 0.1);                           // "0.1"
+ *
+ * Integers are written two digits at a time from a 200-byte table.
+ * Doubles use Grisu2 (Florian Loitsch, "Printing Floating-Point Numbers
+ * Quickly and Accurately with Integers", PLDI 2010): the output always
+ * parses back (strtod) to the exact same double, and is the shortest such
+ * digit string for all but a tiny fraction of inputs, where it may be one
+ * digit longer. Layout follows JavaScript's Number#toString:
+ *   1.5, 100, 0.000123, 1.5e-7, 1e+21, -0, nan, inf
+ *
+ * Buffers are not NUL-terminated; every function returns the length.
+ */
+
+#ifndef NUMFMT_H
+#define NUMFMT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Longest output of any numfmt_* function ("-2.2250738585072014e-308") */
+#define NUMFMT_MAX 32
+
+static const char numfmt__digits2[201] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
+static inline unsigned numfmt__count_digits(uint64_t v) {
+  unsigned n = 1;
+  for (;;) {
+    if (v < 10)
+      return n;
+    if (v < 100)
+      return n + 1;
+    if (v < 1000)
+      return n + 2;
+    if (v < 10000)
+      return n + 3;
+    v /= 10000;
+    n += 4;
+  }
+}
+
+/* Write exactly `len` digits of v ending at buf + len */
+static inline void numfmt__write_digits(char *buf, unsigned len, uint64_t v) {
+  char *p = buf + len;
+  while (v >= 100) {
+    unsigned i = (unsigned)(v % 100) * 2;
+    v /= 100;
+    *--p = numfmt__digits2[i + 1];
+    *--p = numfmt__digits2[i];
+  }
+  if (v >= 10) {
+    *--p = numfmt__digits2[v * 2 + 1];
+    *--p = numfmt__digits2[v * 2];
+  } else {
+    *--p = (char)('0' + v);
+  }
+}
+
+static inline size_t numfmt_u64(char *buf, uint64_t v) {
+  unsigned len = numfmt__count_digits(v);
+  numfmt__write_digits(buf, len, v);
+  return len;
+}
+
+static inline size_t numfmt_i64(char *buf, int64_t v) {
+  if (v >= 0)
+    return numfmt_u64(buf, (uint64_t)v);
+  *buf = '-';
+  return 1 + numfmt_u64(buf + 1, 0 - (uint64_t)v);
+}
+
+/* ========================= Grisu2 ========================= */
+
+typedef struct {
+  uint64_t f;
+  int e;
+} numfmt__fp; /* f * 2^e */
+
+static inline numfmt__fp numfmt__fp_mul(numfmt__fp a, numfmt__fp b) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t p = (__uint128_t)a.f * b.f;
+  uint64_t h = (uint64_t)(p >> 64) + ((uint64_t)p >> 63); /* round */
+  return (numfmt__fp){h, a.e + b.e + 64};
+#else
+  const uint64_t M32 = 0xFFFFFFFFu;
+  uint64_t ah = a.f >> 32, al = a.f & M32, bh = b.f >> 32, bl = b.f & M32;
+  uint64_t hh = ah * bh, hl = ah * bl, lh = al * bh, ll = al * bl;
+  uint64_t mid = (ll >> 32) + (hl & M32) + (lh & M32) + (1u << 31);
+  return (numfmt__fp){hh + (hl >> 32) + (lh >> 32) + (mid >> 32),
+                      a.e + b.e + 64};
+#endif
+}
+
+static inline numfmt__fp numfmt__fp_normalize(numfmt__fp x) {
+  while (!(x.f & ((uint64_t)1 << 63))) {
+    x.f <<= 1;
+    x.e--;
+  }
+  return x;
+}
+
+/* 10^k for k = -348, -340, ..., 340 as normalized 64-bit significands */
+static const uint64_t numfmt__pow10_f[87] = {
+    0xfa8fd5a0081c0288ull, 0xbaaee17fa23ebf76ull, 0x8b16fb203055ac76ull,
+    0xcf42894a5dce35eaull, 0x9a6bb0aa55653b2dull, 0xe61acf033d1a45dfull,
+    0xab70fe17c79ac6caull, 0xff77b1fcbebcdc4full, 0xbe5691ef416bd60cull,
+    0x8dd01fad907ffc3cull, 0xd3515c2831559a83ull, 0x9d71ac8fada6c9b5ull,
+    0xea9c227723ee8bcbull, 0xaecc49914078536dull, 0x823c12795db6ce57ull,
+    0xc21094364dfb5637ull, 0x9096ea6f3848984full, 0xd77485cb25823ac7ull,
+    0xa086cfcd97bf97f4ull, 0xef340a98172aace5ull, 0xb23867fb2a35b28eull,
+    0x84c8d4dfd2c63f3bull, 0xc5dd44271ad3cdbaull, 0x936b9fcebb25c996ull,
+    0xdbac6c247d62a584ull, 0xa3ab66580d5fdaf6ull, 0xf3e2f893dec3f126ull,
+    0xb5b5ada8aaff80b8ull, 0x87625f056c7c4a8bull, 0xc9bcff6034c13053ull,
+    0x964e858c91ba2655ull, 0xdff9772470297ebdull, 0xa6dfbd9fb8e5b88full,
+    0xf8a95fcf88747d94ull, 0xb94470938fa89bcfull, 0x8a08f0f8bf0f156bull,
+    0xcdb02555653131b6ull, 0x993fe2c6d07b7facull, 0xe45c10c42a2b3b06ull,
+    0xaa242499697392d3ull, 0xfd87b5f28300ca0eull, 0xbce5086492111aebull,
+    0x8cbccc096f5088ccull, 0xd1b71758e219652cull, 0x9c40000000000000ull,
+    0xe8d4a51000000000ull, 0xad78ebc5ac620000ull, 0x813f3978f8940984ull,
+    0xc097ce7bc90715b3ull, 0x8f7e32ce7bea5c70ull, 0xd5d238a4abe98068ull,
+    0x9f4f2726179a2245ull, 0xed63a231d4c4fb27ull, 0xb0de65388cc8ada8ull,
+    0x83c7088e1aab65dbull, 0xc45d1df942711d9aull, 0x924d692ca61be758ull,
+    0xda01ee641a708deaull, 0xa26da3999aef774aull, 0xf209787bb47d6b85ull,
+    0xb454e4a179dd1877ull, 0x865b86925b9bc5c2ull, 0xc83553c5c8965d3dull,
+    0x952ab45cfa97a0b3ull, 0xde469fbd99a05fe3ull, 0xa59bc234db398c25ull,
+    0xf6c69a72a3989f5cull, 0xb7dcbf5354e9beceull, 0x88fcf317f22241e2ull,
+    0xcc20ce9bd35c78a5ull, 0x98165af37b2153dfull, 0xe2a0b5dc971f303aull,
+    0xa8d9d1535ce3b396ull, 0xfb9b7cd9a4a7443cull, 0xbb764c4ca7a44410ull,
+    0x8bab8eefb6409c1aull, 0xd01fef10a657842cull, 0x9b10a4e5e9913129ull,
+    0xe7109bfba19c0c9dull, 0xac2820d9623bf429ull, 0x80444b5e7aa7cf85ull,
+    0xbf21e44003acdd2dull, 0x8e679c2f5e44ff8full, 0xd433179d9c8cb841ull,
+    0x9e19db92b4e31ba9ull, 0xeb96bf6ebadf77d9ull, 0xaf87023b9bf0ee6bull,
+};
+
+static const int16_t numfmt__pow10_e[87] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066,
+};
+
+static const uint64_t numfmt__pow10_u64[20] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u,
+    1000000000u, 10000000000u, 100000000000u, 1000000000000u, 10000000000000u,
+    100000000000000u, 1000000000000000u, 10000000000000000u,
+    100000000000000000u, 1000000000000000000u, 10000000000000000000u,
+};
+
+/* Cached power c = 10^-k such that w * c lands in the digit-gen range */
+static inline numfmt__fp numfmt__cached_pow(int e, int *k) {
+  double dk = (-61 - e) * 0.30102999566398114 + 347;
+  int ik = (int)dk;
+  if (dk - ik > 0.0)
+    ik++;
+  unsigned i = (unsigned)((ik >> 3) + 1);
+  *k = -(-348 + (int)i * 8);
+  return (numfmt__fp){numfmt__pow10_f[i], numfmt__pow10_e[i]};
+}
+
+static inline void numfmt__round(char *buf, unsigned len, uint64_t delta,
+                                 uint64_t rest, uint64_t ten_kappa,
+                                 uint64_t wp_w) {
+  while (rest < wp_w && delta - rest >= ten_kappa &&
+         (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+    buf[len - 1]--;
+    rest += ten_kappa;
+  }
+}
+
+/* Shortest digits of the interval (wm, wp); value = digits * 10^k */
+static inline unsigned numfmt__digit_gen(numfmt__fp w, numfmt__fp wp,
+                                         uint64_t delta, char *buf, int *k) {
+  const int shift = -wp.e;
+  const uint64_t one = (uint64_t)1 << shift;
+  uint64_t wp_w = wp.f - w.f;
+  uint32_t p1 = (uint32_t)(wp.f >> shift);
+  uint64_t p2 = wp.f & (one - 1);
+  int kappa = (int)numfmt__count_digits(p1);
+  unsigned len = 0;
+
+  while (kappa > 0) {
+    uint32_t div = (uint32_t)numfmt__pow10_u64[kappa - 1];
+    uint32_t d = p1 / div;
+    p1 %= div;
+    if (d || len)
+      buf[len++] = (char)('0' + d);
+    kappa--;
+    uint64_t rest = ((uint64_t)p1 << shift) + p2;
+    if (rest <= delta) {
+      *k += kappa;
+      numfmt__round(buf, len, delta, rest,
+                    numfmt__pow10_u64[kappa] << shift, wp_w);
+      return len;
+    }
+  }
+  for (;;) {
+    p2 *= 10;
+    delta *= 10;
+    char d = (char)(p2 >> shift);
+    if (d || len)
+      buf[len++] = (char)('0' + d);
+    p2 &= one - 1;
+    kappa--;
+    if (p2 < delta) {
+      *k += kappa;
+      numfmt__round(buf, len, delta, p2, one,
+                    wp_w * numfmt__pow10_u64[-kappa]);
+      return len;
+    }
+  }
+}
+
+/* Digits of a finite v > 0 into buf (<= 17), exponent into *k */
+static inline unsigned numfmt__grisu2(double v, char *buf, int *k) {
+  uint64_t bits;
+  memcpy(&bits, &v, sizeof bits);
+  uint64_t frac = bits & (((uint64_t)1 << 52) - 1);
+  int bexp = (int)((bits >> 52) & 0x7FF);
+  numfmt__fp w = bexp ? (numfmt__fp){frac | ((uint64_t)1 << 52), bexp - 1075}
+                      : (numfmt__fp){frac, -1074};
+
+  /* Boundaries halfway to the neighbouring doubles */
+  numfmt__fp plus = numfmt__fp_normalize((numfmt__fp){(w.f << 1) + 1, w.e - 1});
+  numfmt__fp minus = (w.f == ((uint64_t)1 << 52))
+                         ? (numfmt__fp){(w.f << 2) - 1, w.e - 2}
+                         : (numfmt__fp){(w.f << 1) - 1, w.e - 1};
+  minus.f <<= minus.e - plus.e;
+  minus.e = plus.e;
+
+  int mk;
+  numfmt__fp c = numfmt__cached_pow(plus.e, &mk);
+  numfmt__fp W = numfmt__fp_mul(numfmt__fp_normalize(w), c);
+  numfmt__fp Wp = numfmt__fp_mul(plus, c);
+  numfmt__fp Wm = numfmt__fp_mul(minus, c);
+  Wm.f++;
+  Wp.f--;
+  *k = mk;
+  return numfmt__digit_gen(W, Wp, Wp.f - Wm.f, buf, k);
+}
+
+static inline size_t numfmt__exponent(char *buf, int e) {
+  char *p = buf;
+  *p++ = 'e';
+  *p++ = e < 0 ? '-' : '+';
+  return 2 + numfmt_u64(p, (uint64_t)(e < 0 ? -e : e));
+}
+
+/* Place digits d[0..len) * 10^k into buf, JavaScript-style */
+static inline size_t numfmt__layout(char *buf, unsigned len, int k) {
+  int kk = (int)len + k; /* 10^(kk-1) <= v < 10^kk */
+  if (k >= 0 && kk <= 21) { /* 1234e2 -> 123400 */
+    memset(buf + len, '0', (size_t)k);
+    return (size_t)kk;
+  }
+  if (kk > 0 && kk <= 21) { /* 1234e-2 -> 12.34 */
+    memmove(buf + kk + 1, buf + kk, len - (size_t)kk);
+    buf[kk] = '.';
+    return len + 1;
+  }
+  if (kk > -6 && kk <= 0) { /* 1234e-6 -> 0.001234 */
+    size_t z = (size_t)(2 - kk);
+    memmove(buf + z, buf, len);
+    buf[0] = '0';
+    buf[1] = '.';
+    memset(buf + 2, '0', z - 2);
+    return len + z;
+  }
+  if (len == 1) /* 1e30 */
+    return 1 + numfmt__exponent(buf + 1, kk - 1);
+  memmove(buf + 2, buf + 1, len - 1); /* 1234e30 -> 1.234e+33 */
+  buf[1] = '.';
+  return len + 1 + numfmt__exponent(buf + len + 1, kk - 1);
+}
+
+static inline size_t numfmt_f64(char *buf, double v) {
+  uint64_t bits;
+  memcpy(&bits, &v, sizeof bits);
+  char *p = buf;
+  if ((bits >> 52 & 0x7FF) == 0x7FF) {
+    if (bits << 12) {
+      memcpy(buf, "nan", 3);
+      return 3;
+    }
+    if (bits >> 63)
+      *p++ = '-';
+    memcpy(p, "inf", 3);
+    return (size_t)(p - buf) + 3;
+  }
+  if (bits >> 63) {
+    *p++ = '-';
+    v = -v;
+  }
+  if (v == 0.0) {
+    *p = '0';
+    return (size_t)(p - buf) + 1;
+  }
+  /* Integers below 2^53 print exactly; skip Grisu for them */
+  if (v < 9007199254740992.0 && v == (double)(uint64_t)v)
+    return (size_t)(p - buf) + numfmt_u64(p, (uint64_t)v);
+  int k;
+  unsigned len = numfmt__grisu2(v, p, &k);
+  return (size_t)(p - buf) + numfmt__layout(p, len, k);
+}
+
+#endif /* NUMFMT_H */
@@ -0,0 +1,136 @@
+/*
+ * numfmt_bench.c — strbuilder number appenders vs snprintf
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 numfmt_bench.c -o numfmt_bench
+ *
+ * Appends 10M values to a strbuilder_t (cleared every 4096 appends so it
+ * stays cache-resident) and reports ns per value:
+ *   u64 / i64 — snprintf "%llu" / "%lld" vs strbuilder_append_u64 / _i64
+ *   f64       — snprintf "%.17g" (the shortest printf format that always
+ *               round-trips) vs strbuilder_append_f64 (Grisu2, shortest)
+ *   appendf   — the old measure-then-write strbuilder_appendf (two
+ *               vsnprintf calls) vs the current single-pass one
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "strbuilder.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define COUNT 10000000
+#define CLEAR_EVERY 4096
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* strbuilder_appendf before the single-pass change */
+static int appendf_two_pass(strbuilder_t *sb, const char *fmt, ...) {
+  va_list args, args_copy;
+  va_start(args, fmt);
+  va_copy(args_copy, args);
+  int needed = vsnprintf(NULL, 0, fmt, args_copy);
+  va_end(args_copy);
+  if (needed < 0 || !strbuilder_ensure(sb, needed)) {
+    va_end(args);
+    return 0;
+  }
+  vsnprintf(strbuilder__buf(sb) + sb->len, needed + 1, fmt, args);
+  sb->len += needed;
+  va_end(args);
+  return 1;
+}
+
+static uint64_t rng = 0x9E3779B97F4A7C15u;
+
+static uint64_t next_u64(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+/* Metric-like magnitudes: mostly small, some large */
+static uint64_t sample_u64(uint64_t r) { return r >> (r % 64); }
+
+static double sample_f64(uint64_t r) {
+  return (double)(r >> 40) / (double)(1 + (r & 0xFFFF)) * 0.001;
+}
+
+static volatile size_t g_sink;
+
+#define BENCH(label, EXPR)                                                     \
+  do {                                                                         \
+    strbuilder_t sb = {0};                                                     \
+    rng = 0x9E3779B97F4A7C15u;                                                 \
+    double t0 = now_sec();                                                     \
+    for (int i = 0; i < COUNT; i++) {                                          \
+      uint64_t r = next_u64();                                                 \
+      (void)r;                                                                 \
+      EXPR;                                                                    \
+      if (i % CLEAR_EVERY == CLEAR_EVERY - 1) {                                \
+        g_sink += sb.len;                                                      \
+        strbuilder_clear(&sb);                                                 \
+      }                                                                        \
+    }                                                                          \
+    label = (now_sec() - t0) * 1e9 / COUNT;                                    \
+    strbuilder_free(&sb);                                                      \
+  } while (0)
+
+static void report(const char *name, const char *base, double base_ns,
+                   const char *fast, double fast_ns) {
+  printf("  %-8s %-20s %6.1f ns   %-22s %6.1f ns   %5.2fx\n", name, base,
+         base_ns, fast, fast_ns, base_ns / fast_ns);
+}
+
+int main(void) {
+  /* Same text either way (f64 compares the parsed value instead) */
+  char a[64], b[NUMFMT_MAX + 1];
+  for (int i = 0; i < 100000; i++) {
+    uint64_t r = next_u64();
+    snprintf(a, sizeof a, "%llu", (unsigned long long)sample_u64(r));
+    b[numfmt_u64(b, sample_u64(r))] = '\0';
+    assert(strcmp(a, b) == 0);
+    double d = sample_f64(r);
+    b[numfmt_f64(b, d)] = '\0';
+    assert(strtod(b, NULL) == d);
+  }
+
+  double base, fast;
+  BENCH(base, {
+    char tmp[32];
+    int n = snprintf(tmp, sizeof tmp, "%llu",
+                     (unsigned long long)sample_u64(r));
+    strbuilder_append_n(&sb, tmp, (size_t)n);
+  });
+  BENCH(fast, strbuilder_append_u64(&sb, sample_u64(r)));
+  report("u64", "snprintf %llu", base, "strbuilder_append_u64", fast);
+
+  BENCH(base, {
+    char tmp[32];
+    int n = snprintf(tmp, sizeof tmp, "%lld", (long long)r);
+    strbuilder_append_n(&sb, tmp, (size_t)n);
+  });
+  BENCH(fast, strbuilder_append_i64(&sb, (int64_t)r));
+  report("i64", "snprintf %lld", base, "strbuilder_append_i64", fast);
+
+  BENCH(base, {
+    char tmp[32];
+    int n = snprintf(tmp, sizeof tmp, "%.17g", sample_f64(r));
+    strbuilder_append_n(&sb, tmp, (size_t)n);
+  });
+  BENCH(fast, strbuilder_append_f64(&sb, sample_f64(r)));
+  report("f64", "snprintf %.17g", base, "strbuilder_append_f64", fast);
+
+  BENCH(base, appendf_two_pass(&sb, "cpu=%d mem=%u\n", (int)(r % 100),
+                               (unsigned)(r >> 40)));
+  BENCH(fast, strbuilder_appendf(&sb, "cpu=%d mem=%u\n", (int)(r % 100),
+                                 (unsigned)(r >> 40)));
+  report("appendf", "two-pass vsnprintf", base, "single-pass", fast);
+  return 0;
+}
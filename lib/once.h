@@ -0,0 +1,104 @@
+/*
+ * once.h — One-time / lazy initialization with a lock-free fast path (C11)
+ *
+ * Double-checked locking done right: the "already initialized" check is a
+ * single acquire load, so after the first call readers never touch the
+ * mutex. Only threads that race the very first initialization take the
+ * slow path, where exactly one of them runs the initializer and the rest
+ * block until it has published the value.
+ *
+ * Generic over the value type:
+ *
+ *   typedef struct { uint8_t lut[256]; } crc_table_t;
+ *   static void build_crc_table(crc_table_t *t) { ... }
+ *
+ *   static lazy_t(crc_table_t) crc = LAZY_INIT;
+ *   uint8_t x = lazy_get(&crc, build_crc_table)->lut[b];
+ *
+ * or generate a typed accessor function:
+ *
+ *   LAZY_STATIC(config_t, get_config, load_config)
+ *   ... get_config()->port ...
+ *
+ * Compile with -pthread. See once_bench.c for fast-path cost.
+ */
+
+#ifndef ONCE_H
+#define ONCE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+
+typedef struct {
+  atomic_int done;
+  pthread_mutex_t mutex;
+} once_t;
+
+#define ONCE_INIT {0, PTHREAD_MUTEX_INITIALIZER}
+
+#if defined(__GNUC__)
+#define ONCE__UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define ONCE__NOINLINE __attribute__((noinline, unused))
+#else
+#define ONCE__UNLIKELY(x) (x)
+#define ONCE__NOINLINE
+#endif
+
+/* Slow path: returns true with the mutex held if the caller must run the
+ * initializer and then call once_leave(). */
+static ONCE__NOINLINE bool once__enter_slow(once_t *o) {
+  pthread_mutex_lock(&o->mutex);
+  if (atomic_load_explicit(&o->done, memory_order_relaxed)) {
+    pthread_mutex_unlock(&o->mutex);
+    return false;
+  }
+  return true;
+}
+
+/* Returns false (the common case) once initialization has completed. */
+static inline bool once_enter(once_t *o) {
+  if (ONCE__UNLIKELY(!atomic_load_explicit(&o->done, memory_order_acquire)))
+    return once__enter_slow(o);
+  return false;
+}
+
+/* Publish the initialized value and release waiting threads. */
+static inline void once_leave(once_t *o) {
+  atomic_store_explicit(&o->done, 1, memory_order_release);
+  pthread_mutex_unlock(&o->mutex);
+}
+
+/* pthread_once-style call with an argument */
+static inline void once_call(once_t *o, void (*fn)(void *), void *arg) {
+  if (once_enter(o)) {
+    fn(arg);
+    once_leave(o);
+  }
+}
+
+/* ========================= lazy values ========================= */
+
+#define lazy_t(Type)                                                           \
+  struct {                                                                     \
+    once_t once;                                                               \
+    Type value;                                                                \
+  }
+
+#define LAZY_INIT {.once = ONCE_INIT}
+
+/* Evaluates to a pointer to the value, running init_fn(&value) exactly once.
+ * init_fn may be any function (or macro) taking a pointer to the value. */
+#define lazy_get(l, init_fn)                                                   \
+  (once_enter(&(l)->once)                                                      \
+       ? (init_fn(&(l)->value), once_leave(&(l)->once), &(l)->value)           \
+       : &(l)->value)
+
+/* Defines `static Type *name(void)` returning the lazily built value. */
+#define LAZY_STATIC(Type, name, init_fn)                                       \
+  static Type *name(void) {                                                    \
+    static lazy_t(Type) name##__lazy = LAZY_INIT;                              \
+    return lazy_get(&name##__lazy, init_fn);                                   \
+  }
+
+#endif /* ONCE_H */
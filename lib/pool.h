@@ -0,0 +1,253 @@
+/*
+ * pool.h — O(1) fixed-size block pool with an intrusive free list (C11)
+ *
+ * All blocks have the same size. A free block stores the free-list link in
+ * its own first bytes, so there is no per-block bookkeeping and both
+ * pool_alloc and pool_free are a single pointer pop/push. When the list
+ * runs dry the pool grows by one chunk of `blocks_per_chunk` blocks; chunks
+ * are only returned to the system by pool_destroy.
+ *
+ *   pool_t particles;
+ *   pool_init(&particles, sizeof(Particle), 1024);
+ *   Particle *p = pool_alloc(&particles);
+ *   pool_free(&particles, p);
+ *   pool_destroy(&particles);
+ *
+ * Cross-thread frees: a pool is owned by one thread (the one calling
+ * pool_alloc / pool_free). Other threads hand blocks back with
+ * pool_free_remote(), a lock-free push onto a separate stack; the owner
+ * adopts that whole stack with one atomic exchange when its local list is
+ * empty. Only the owner ever pops, so the stack has no ABA problem.
+ *
+ * Debug mode (-DPOOL_DEBUG): fresh blocks are filled with 0xCD and freed
+ * blocks with 0xDD; pool_free checks that the pointer is a block of this
+ * pool and not already free, and pool_alloc checks that nobody wrote into
+ * a free block. Violations call POOL_ON_ERROR.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef POOL_DEBUG
+#include <stdio.h>
+#endif
+
+/* Optional: custom allocators for chunks */
+#ifndef POOL_MALLOC
+#define POOL_MALLOC malloc
+#endif
+
+#ifndef POOL_FREE
+#define POOL_FREE free
+#endif
+
+/* Optional: OOM handler (string describing failed op) */
+#ifndef POOL_ON_OOM
+#define POOL_ON_OOM(msg) ((void)0)
+#endif
+
+/* Optional: debug-mode error handler */
+#ifndef POOL_ON_ERROR
+#define POOL_ON_ERROR(msg, ptr)                                                \
+  (fprintf(stderr, "pool: %s (%p)\n", (msg), (ptr)), abort())
+#endif
+
+#define POOL_ALLOC_BYTE 0xCD
+#define POOL_FREE_BYTE 0xDD
+#define POOL_FREE_MAGIC ((uintptr_t)0xDEADF4EEDEADF4EEull)
+
+typedef struct pool_node {
+  struct pool_node *next;
+#ifdef POOL_DEBUG
+  uintptr_t magic; /* POOL_FREE_MAGIC while on a free list */
+#endif
+} pool_node_t;
+
+typedef struct pool_chunk {
+  struct pool_chunk *next;
+  alignas(max_align_t) unsigned char data[];
+} pool_chunk_t;
+
+typedef struct {
+  size_t block_size;
+  size_t blocks_per_chunk;
+  pool_node_t *free_list;
+  pool_chunk_t *chunks;
+  size_t capacity; /* total blocks across chunks */
+  size_t in_use;   /* owner-side count; remote frees settle on adoption */
+  _Atomic(pool_node_t *) remote_free;
+} pool_t;
+
+/* ========================= internals ========================= */
+
+static inline bool pool__grow(pool_t *p) {
+  size_t bytes = p->block_size * p->blocks_per_chunk;
+  pool_chunk_t *c = (pool_chunk_t *)POOL_MALLOC(sizeof(pool_chunk_t) + bytes);
+  if (!c) {
+    POOL_ON_OOM("pool chunk allocation failed");
+    return false;
+  }
+  c->next = p->chunks;
+  p->chunks = c;
+  /* Thread the new blocks front to back so allocation order is linear */
+  for (size_t i = p->blocks_per_chunk; i-- > 0;) {
+    pool_node_t *n = (pool_node_t *)(c->data + i * p->block_size);
+#ifdef POOL_DEBUG
+    memset(n, POOL_FREE_BYTE, p->block_size);
+    n->magic = POOL_FREE_MAGIC;
+#endif
+    n->next = p->free_list;
+    p->free_list = n;
+  }
+  p->capacity += p->blocks_per_chunk;
+  return true;
+}
+
+/* Take everything other threads have freed */
+static inline bool pool__adopt_remote(pool_t *p) {
+  pool_node_t *list =
+      atomic_exchange_explicit(&p->remote_free, NULL, memory_order_acquire);
+  if (!list)
+    return false;
+  size_t n = 1;
+  pool_node_t *last = list;
+  for (; last->next; n++)
+    last = last->next;
+  last->next = p->free_list;
+  p->free_list = list;
+  p->in_use -= n;
+  return true;
+}
+
+#ifdef POOL_DEBUG
+static inline bool pool__owns(const pool_t *p, const void *ptr) {
+  for (const pool_chunk_t *c = p->chunks; c; c = c->next) {
+    const unsigned char *b = (const unsigned char *)ptr;
+    if (b >= c->data && b < c->data + p->block_size * p->blocks_per_chunk)
+      return (size_t)(b - c->data) % p->block_size == 0;
+  }
+  return false;
+}
+
+/* Returns false (after reporting) if ptr must not be freed */
+static inline bool pool__check_free(const pool_t *p, void *ptr) {
+  if (!pool__owns(p, ptr)) {
+    POOL_ON_ERROR("free of pointer not owned by pool", ptr);
+    return false;
+  }
+  if (((pool_node_t *)ptr)->magic == POOL_FREE_MAGIC) {
+    POOL_ON_ERROR("double free", ptr);
+    return false;
+  }
+  return true;
+}
+
+static inline void pool__poison(const pool_t *p, pool_node_t *n) {
+  memset(n, POOL_FREE_BYTE, p->block_size);
+  n->magic = POOL_FREE_MAGIC;
+}
+#endif
+
+/* ========================= public API ========================= */
+
+/* block_size is rounded up to hold a free-list link and keep every block
+ * aligned like malloc's */
+static inline void pool_init(pool_t *p, size_t block_size,
+                             size_t blocks_per_chunk) {
+  size_t align = alignof(max_align_t);
+  if (block_size < sizeof(pool_node_t))
+    block_size = sizeof(pool_node_t);
+  p->block_size = (block_size + align - 1) & ~(align - 1);
+  p->blocks_per_chunk = blocks_per_chunk ? blocks_per_chunk : 64;
+  p->free_list = NULL;
+  p->chunks = NULL;
+  p->capacity = 0;
+  p->in_use = 0;
+  atomic_init(&p->remote_free, NULL);
+}
+
+static inline void pool_destroy(pool_t *p) {
+  pool_chunk_t *c = p->chunks;
+  while (c) {
+    pool_chunk_t *next = c->next;
+    POOL_FREE(c);
+    c = next;
+  }
+  p->chunks = NULL;
+  p->free_list = NULL;
+  p->capacity = p->in_use = 0;
+  atomic_store(&p->remote_free, NULL);
+}
+
+static inline void *pool_alloc(pool_t *p) {
+  if (!p->free_list && !pool__adopt_remote(p) && !pool__grow(p))
+    return NULL;
+  pool_node_t *n = p->free_list;
+  p->free_list = n->next;
+  p->in_use++;
+#ifdef POOL_DEBUG
+  if (n->magic != POOL_FREE_MAGIC)
+    POOL_ON_ERROR("free block was written to (use after free?)", (void *)n);
+  const unsigned char *b = (const unsigned char *)n;
+  for (size_t i = sizeof(pool_node_t); i < p->block_size; i++) {
+    if (b[i] != POOL_FREE_BYTE) {
+      POOL_ON_ERROR("free block was written to (use after free?)", (void *)n);
+      break;
+    }
+  }
+  memset(n, POOL_ALLOC_BYTE, p->block_size);
+#endif
+  return n;
+}
+
+/* Owner-thread free */
+static inline void pool_free(pool_t *p, void *ptr) {
+  if (!ptr)
+    return;
+#ifdef POOL_DEBUG
+  if (!pool__check_free(p, ptr))
+    return;
+  pool__poison(p, (pool_node_t *)ptr);
+#endif
+  pool_node_t *n = (pool_node_t *)ptr;
+  n->next = p->free_list;
+  p->free_list = n;
+  p->in_use--;
+}
+
+/* Free from any thread (lock-free). The owner reclaims the block on its
+ * next pool_alloc that finds the local list empty. */
+static inline void pool_free_remote(pool_t *p, void *ptr) {
+  if (!ptr)
+    return;
+#ifdef POOL_DEBUG
+  /* The chunk list is only appended to by the owner, and an ownership
+   * check here would race with growth; only catch double frees. */
+  if (((pool_node_t *)ptr)->magic == POOL_FREE_MAGIC) {
+    POOL_ON_ERROR("double free", ptr);
+    return;
+  }
+  pool__poison(p, (pool_node_t *)ptr);
+#endif
+  pool_node_t *n = (pool_node_t *)ptr;
+  pool_node_t *head =
+      atomic_load_explicit(&p->remote_free, memory_order_relaxed);
+  do {
+    n->next = head;
+  } while (!atomic_compare_exchange_weak_explicit(
+      &p->remote_free, &head, n, memory_order_release, memory_order_relaxed));
+}
+
+/* Blocks currently handed out (remote frees not yet adopted count as live) */
+static inline size_t pool_in_use(const pool_t *p) { return p->in_use; }
+static inline size_t pool_capacity(const pool_t *p) { return p->capacity; }
+
+#endif /* POOL_H */
@@ -0,0 +1,78 @@
+/*
+ * pool_demo.c — demo for pool.h
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 -pthread pool_demo.c -o pool_demo
+ *   gcc -std=c11 -O2 -pthread -DPOOL_DEBUG pool_demo.c -o pool_demo_debug
+ */
+
+#include <stdio.h>
+
+/* Report debug-mode errors instead of aborting */
+static int g_errors __attribute__((unused));
+#define POOL_ON_ERROR(msg, ptr) (printf("caught: %s\n", (msg)), g_errors++)
+
+#include "pool.h"
+#include <assert.h>
+#include <pthread.h>
+
+typedef struct {
+  float x, y, vx, vy;
+  int ttl;
+} particle;
+
+#define N 10000
+
+static pool_t g_pool;
+static particle *g_handoff[N];
+
+static void *remote_freer(void *arg) {
+  (void)arg;
+  for (int i = 0; i < N; i++)
+    pool_free_remote(&g_pool, g_handoff[i]);
+  return NULL;
+}
+
+int main(void) {
+  pool_init(&g_pool, sizeof(particle), 256);
+
+  /* Churn: spawn and retire particles, O(1) each */
+  particle *live[N];
+  for (int i = 0; i < N; i++) {
+    live[i] = pool_alloc(&g_pool);
+    live[i]->ttl = i % 60;
+  }
+  for (int i = 0; i < N; i += 2)
+    pool_free(&g_pool, live[i]);
+  for (int i = 0; i < N; i += 2)
+    live[i] = pool_alloc(&g_pool); /* reuses the freed blocks */
+  printf("in use %zu, capacity %zu\n", pool_in_use(&g_pool),
+         pool_capacity(&g_pool)); // Expected: 10000, 10240
+
+  /* Another thread returns every block */
+  for (int i = 0; i < N; i++)
+    g_handoff[i] = live[i];
+  pthread_t t;
+  pthread_create(&t, NULL, remote_freer, NULL);
+  pthread_join(t, NULL);
+
+  /* Owner adopts the remote frees instead of growing */
+  size_t cap = pool_capacity(&g_pool);
+  for (int i = 0; i < N; i++)
+    live[i] = pool_alloc(&g_pool);
+  assert(pool_capacity(&g_pool) == cap);
+  printf("after remote frees: in use %zu, capacity %zu\n",
+         pool_in_use(&g_pool), pool_capacity(&g_pool));
+
+#ifdef POOL_DEBUG
+  particle *p = live[0];
+  pool_free(&g_pool, p);
+  pool_free(&g_pool, p); /* caught: double free */
+  int on_stack;
+  pool_free(&g_pool, &on_stack); /* caught: not owned by pool */
+  assert(g_errors == 2);
+#endif
+
+  pool_destroy(&g_pool);
+  return 0;
+}
@@ -1,12 +1,26 @@
 #ifndef REACTIVE_H
 #define REACTIVE_H
 
+// Signals live in a pool, so a Signal * stays valid until signal_free()
+// and the graph can hold plain pointers. A Signal is 80 bytes: strings
+// are kept out of line and grow as needed, deps are a heap array of any
+// length. There is no limit on the number of live signals.
+//
+// Computed signals are eager (signal_computed: recomputed as soon as a
+// dep changes) or lazy (signal_lazy: recomputed by get_* only, and only
+// if a dep's version moved since the last read).
+
+#include "pool.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-#define MAX_DEPS 8
-#define MAX_STR 256
+// Signals per pool chunk
+#ifndef REACTIVE_POOL_CHUNK
+#define REACTIVE_POOL_CHUNK 256
+#endif
 
 // Signal types
 typedef struct Signal Signal;
@@ -14,118 +28,350 @@ typedef struct Signal Signal;
 typedef enum { SIG_INT, SIG_DOUBLE, SIG_STRING } SignalType;
 
 struct Signal {
-  SignalType type;
-  bool dirty;
-
   union {
     int i;
     double d;
-    char s[MAX_STR];
+    struct {
+      char *ptr; // NULL reads as ""
+      uint32_t len, cap;
+    } s;
   } val;
 
   // For computed signals
-  Signal *deps[MAX_DEPS];
-  int dep_count;
+  Signal **deps;
   void (*compute)(Signal *self);
+
+  // Graph: signals that read this one, and this one's depth in the graph
+  // (0 for sources, 1 + the deepest dep for computed signals)
+  Signal **subs;
+
+  // Versions, in ticks of g_epoch: when the value last changed, and (lazy
+  // signals) when it was last checked against its deps; 0 = never
+  uint64_t changed_at, verified_at;
+
+  SignalType type;
+  int dep_count;
+  int sub_count, sub_cap;
+  int height;
+  bool dirty, queued, lazy;
 };
 
-// Global registry
-static Signal *g_all_signals[128]; // increased a bit
-static int g_signal_count = 0;
+#ifndef REACTIVE_ON_OOM
+#define REACTIVE_ON_OOM(msg) abort()
+#endif
+
+// ===== Pool =====
+static pool_t g_signal_pool;
+static bool g_signal_pool_ready = false;
 
-static inline void register_signal(Signal *s) {
-  if (g_signal_count < 128) {
-    g_all_signals[g_signal_count++] = s;
+static inline Signal *reactive__alloc(void) {
+  if (!g_signal_pool_ready) {
+    pool_init(&g_signal_pool, sizeof(Signal), REACTIVE_POOL_CHUNK);
+    g_signal_pool_ready = true;
   }
+  Signal *s = (Signal *)pool_alloc(&g_signal_pool);
+  if (!s)
+    REACTIVE_ON_OOM("reactive: out of memory");
+  memset(s, 0, sizeof *s);
+  return s;
+}
+
+static inline size_t reactive_live_signals(void) {
+  return g_signal_pool_ready ? pool_in_use(&g_signal_pool) : 0;
+}
+
+static inline void *reactive__grow(void *arr, int *cap, size_t elem) {
+  int ncap = *cap ? *cap * 2 : 4;
+  void *p = realloc(arr, (size_t)ncap * elem);
+  if (!p)
+    REACTIVE_ON_OOM("reactive: out of memory");
+  *cap = ncap;
+  return p;
 }
 
 // ===== Create Signals =====
-static inline Signal signal_int(int value) {
-  Signal s = {.type = SIG_INT, .val.i = value};
-  register_signal(&s); // auto-register everything
+static inline Signal *signal_int(int value) {
+  Signal *s = reactive__alloc();
+  s->type = SIG_INT;
+  s->val.i = value;
   return s;
 }
 
-static inline Signal signal_double(double value) {
-  Signal s = {.type = SIG_DOUBLE, .val.d = value};
-  register_signal(&s);
+static inline Signal *signal_double(double value) {
+  Signal *s = reactive__alloc();
+  s->type = SIG_DOUBLE;
+  s->val.d = value;
   return s;
 }
 
-static inline Signal signal_string(const char *value) {
-  Signal s = {.type = SIG_STRING};
-  strncpy(s.val.s, value, MAX_STR - 1);
-  register_signal(&s);
+static inline void set_string(Signal *s, const char *value);
+
+static inline Signal *signal_string(const char *value) {
+  Signal *s = reactive__alloc();
+  s->type = SIG_STRING;
+  set_string(s, value); // no subscribers yet, so this cannot propagate
+  s->dirty = false;
   return s;
 }
 
-// ===== Get Values ===== (unchanged)
-static inline int get_int(Signal *s) { return s->val.i; }
-static inline double get_double(Signal *s) { return s->val.d; }
-static inline const char *get_string(Signal *s) { return s->val.s; }
+// ===== Get Values =====
+// Every change outside a lazy signal's compute ticks the epoch, so a lazy
+// signal verified in the current epoch is up to date without looking.
+// Otherwise its deps are brought up to date first (deepest first, so the
+// read is glitch-free) and it recomputes only if one of them changed.
+static uint64_t g_epoch = 1;
+
+static inline void reactive__pull(Signal *s) {
+  if (s->verified_at == g_epoch)
+    return;
+  bool stale = s->verified_at == 0;
+  for (int i = 0; i < s->dep_count; i++) {
+    Signal *d = s->deps[i];
+    if (d->lazy)
+      reactive__pull(d);
+    if (d->changed_at > s->verified_at)
+      stale = true;
+  }
+  if (stale)
+    s->compute(s);
+  s->verified_at = g_epoch;
+}
+
+static inline int get_int(Signal *s) {
+  if (s->lazy)
+    reactive__pull(s);
+  return s->val.i;
+}
+
+static inline double get_double(Signal *s) {
+  if (s->lazy)
+    reactive__pull(s);
+  return s->val.d;
+}
+
+static inline const char *get_string(Signal *s) {
+  if (s->lazy)
+    reactive__pull(s);
+  return s->val.s.ptr ? s->val.s.ptr : "";
+}
 
 // ===== Propagation =====
-static inline void propagate(Signal *changed);
+// Changed signals push their subscribers onto a min-heap keyed by height.
+// Popping lowest height first means every dep of a signal has settled
+// before it recomputes, so each signal computes at most once per flush
+// (no diamond glitches). A compute that leaves its value unchanged stops
+// propagation there.
+static Signal **g_pending = NULL;
+static int g_pending_count = 0, g_pending_cap = 0;
+static int g_batch_depth = 0;
+static bool g_flushing = false;
 
-static inline void set_int(Signal *s, int value) {
-  if (s->val.i != value) {
-    s->val.i = value;
-    s->dirty = true;
-    propagate(s);
+static inline void reactive__enqueue(Signal *s) {
+  if (s->queued)
+    return;
+  s->queued = true;
+  if (g_pending_count == g_pending_cap)
+    g_pending = reactive__grow(g_pending, &g_pending_cap, sizeof(Signal *));
+  int i = g_pending_count++;
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    if (g_pending[parent]->height <= s->height)
+      break;
+    g_pending[i] = g_pending[parent];
+    i = parent;
   }
+  g_pending[i] = s;
 }
 
-static inline void set_double(Signal *s, double value) {
-  if (s->val.d != value) {
-    s->val.d = value;
+static inline Signal *reactive__pop(void) {
+  Signal *top = g_pending[0];
+  Signal *last = g_pending[--g_pending_count];
+  int i = 0;
+  for (;;) {
+    int c = 2 * i + 1;
+    if (c >= g_pending_count)
+      break;
+    if (c + 1 < g_pending_count &&
+        g_pending[c + 1]->height < g_pending[c]->height)
+      c++;
+    if (last->height <= g_pending[c]->height)
+      break;
+    g_pending[i] = g_pending[c];
+    i = c;
+  }
+  if (g_pending_count)
+    g_pending[i] = last;
+  top->queued = false;
+  return top;
+}
+
+static inline void reactive__flush(void) {
+  if (g_flushing)
+    return;
+  g_flushing = true;
+  while (g_pending_count) {
+    Signal *s = reactive__pop();
     s->dirty = true;
-    propagate(s);
+    if (s->lazy) {
+      // not recomputed here; its readers will pull it when they run
+      for (int i = 0; i < s->sub_count; i++)
+        reactive__enqueue(s->subs[i]);
+    } else {
+      s->compute(s); // set_* on self queues s's own subscribers
+    }
+  }
+  g_flushing = false;
+}
+
+static inline void propagate(Signal *changed) {
+  for (int i = 0; i < changed->sub_count; i++)
+    reactive__enqueue(changed->subs[i]);
+  if (g_batch_depth == 0)
+    reactive__flush();
+}
+
+// A lazy signal's own subscribers were queued when its deps changed, so
+// recomputing it on a read only restamps it
+static inline void reactive__changed(Signal *s) {
+  s->dirty = true;
+  if (s->lazy) {
+    s->changed_at = g_epoch;
+    return;
   }
+  s->changed_at = ++g_epoch;
+  propagate(s);
+}
+
+// Batches nest; sets inside one only queue work, and the outermost
+// reactive_batch_end recomputes everything affected once.
+static inline void reactive_batch_begin(void) { g_batch_depth++; }
+
+static inline void reactive_batch_end(void) {
+  if (g_batch_depth > 0 && --g_batch_depth == 0)
+    reactive__flush();
+}
+
+static inline void set_int(Signal *s, int value) {
+  if (s->type == SIG_STRING)
+    free(s->val.s.ptr);
+  else if (s->type == SIG_INT && s->val.i == value)
+    return;
+  s->type = SIG_INT;
+  s->val.i = value;
+  reactive__changed(s);
+}
+
+static inline void set_double(Signal *s, double value) {
+  if (s->type == SIG_STRING)
+    free(s->val.s.ptr);
+  else if (s->type == SIG_DOUBLE && s->val.d == value)
+    return;
+  s->type = SIG_DOUBLE;
+  s->val.d = value;
+  reactive__changed(s);
 }
 
 static inline void set_string(Signal *s, const char *value) {
-  if (strcmp(s->val.s, value) != 0) {
-    strncpy(s->val.s, value, MAX_STR - 1);
-    s->dirty = true;
-    propagate(s);
+  size_t len = strlen(value);
+  if (s->type != SIG_STRING) {
+    s->type = SIG_STRING;
+    s->val.s.ptr = NULL;
+    s->val.s.len = s->val.s.cap = 0;
+  } else if (s->val.s.len == len && s->val.s.ptr &&
+             memcmp(s->val.s.ptr, value, len) == 0) {
+    return;
   }
+  if (len >= s->val.s.cap) {
+    size_t cap = s->val.s.cap ? (size_t)s->val.s.cap * 2 : 16;
+    while (cap <= len)
+      cap *= 2;
+    char *p = (char *)realloc(s->val.s.ptr, cap);
+    if (!p || cap > UINT32_MAX)
+      REACTIVE_ON_OOM("reactive: out of memory");
+    s->val.s.ptr = p;
+    s->val.s.cap = (uint32_t)cap;
+  }
+  memcpy(s->val.s.ptr, value, len + 1);
+  s->val.s.len = (uint32_t)len;
+  reactive__changed(s);
 }
 
-// ===== Computed Signals FIXED =====
-static inline Signal signal_computed(void (*compute)(Signal *self),
-                                     Signal *deps[], int dep_count) {
-  Signal s = {0};
-  s.compute = compute;
-  s.dep_count = dep_count > MAX_DEPS ? MAX_DEPS : dep_count;
+// ===== Computed Signals =====
+static inline Signal *reactive__computed(void (*compute)(Signal *self),
+                                         Signal *deps[], int dep_count,
+                                         bool lazy) {
+  Signal *s = reactive__alloc();
+  s->compute = compute;
+  s->lazy = lazy;
+  if (dep_count > 0) {
+    s->deps = (Signal **)malloc((size_t)dep_count * sizeof(Signal *));
+    if (!s->deps)
+      REACTIVE_ON_OOM("reactive: out of memory");
+    memcpy(s->deps, deps, (size_t)dep_count * sizeof(Signal *));
+  }
+  s->dep_count = dep_count;
 
-  for (int i = 0; i < s.dep_count; i++)
-    s.deps[i] = deps[i];
+  for (int i = 0; i < dep_count; i++) {
+    Signal *d = deps[i];
+    if (d->sub_count == d->sub_cap)
+      d->subs = reactive__grow(d->subs, &d->sub_cap, sizeof(Signal *));
+    d->subs[d->sub_count++] = s;
+    if (d->height + 1 > s->height)
+      s->height = d->height + 1;
+  }
+  return s;
+}
 
-  register_signal(&s); // ← register BEFORE computing
-  compute(&s);         // ← now deps[] are valid and we are registered
-  s.dirty = false;     // initial compute is clean
+// Subscribes to deps (which must outlive it) and computes once. deps is
+// copied, so a temporary array is fine.
+static inline Signal *signal_computed(void (*compute)(Signal *self),
+                                      Signal *deps[], int dep_count) {
+  Signal *s = reactive__computed(compute, deps, dep_count, false);
+  compute(s);       // no subscribers yet, so this cannot propagate
+  s->dirty = false; // initial compute is clean
   return s;
 }
 
-// ===== Propagation (slightly smarter + recursive) =====
-static inline void propagate(Signal *changed) {
-  for (int i = 0; i < g_signal_count; i++) {
-    Signal *candidate = g_all_signals[i];
-    if (!candidate->compute)
-      continue;
-
-    bool depends = false;
-    for (int j = 0; j < candidate->dep_count; j++) {
-      if (candidate->deps[j] == changed) {
-        depends = true;
+// Like signal_computed, but compute runs inside get_* when a dep has
+// changed since the last read, and never for values nobody reads
+static inline Signal *signal_lazy(void (*compute)(Signal *self),
+                                  Signal *deps[], int dep_count) {
+  return reactive__computed(compute, deps, dep_count, true);
+}
+
+// Unsubscribe from deps and return the signal to the pool. Signals that
+// read this one must be freed first.
+static inline void signal_free(Signal *s) {
+  if (!s)
+    return;
+  for (int i = 0; i < s->dep_count; i++) {
+    Signal *d = s->deps[i];
+    for (int j = 0; j < d->sub_count; j++)
+      if (d->subs[j] == s) {
+        d->subs[j] = d->subs[--d->sub_count];
+        break;
+      }
+  }
+  if (s->queued) {
+    for (int i = 0; i < g_pending_count; i++)
+      if (g_pending[i] == s) {
+        // rare; rebuild the heap without s
+        Signal **rest = g_pending;
+        int n = g_pending_count;
+        g_pending_count = 0;
+        for (int j = 0; j < n; j++)
+          if (rest[j] != s) {
+            rest[j]->queued = false;
+            reactive__enqueue(rest[j]);
+          }
         break;
       }
-    }
-    if (depends) {
-      candidate->dirty = true;
-      candidate->compute(candidate); // recompute immediately (pull model)
-    }
   }
+  if (s->type == SIG_STRING)
+    free(s->val.s.ptr);
+  free(s->deps);
+  free(s->subs);
+  pool_free(&g_signal_pool, s);
 }
 
 #endif // REACTIVE_H
@@ -0,0 +1,217 @@
+/*
+ * ringbuf.h — Type-generic single-header ring buffer for C (C99+)
+ *
+ * Same layout trick as dynarray.h: a ring of Type is just `Type *`, with a
+ * small header stored immediately before the element storage. Capacity is
+ * always rounded up to a power of two so slot indices are `pos & mask`
+ * instead of `pos % capacity`, and head/tail are free-running counters
+ * (count is simply head - tail, no `full` flag needed).
+ *
+ * Bulk rb_put_n / rb_get_n copy with at most two memcpy calls (one up to
+ * the wrap point, one from the start of storage).
+ *
+ * Modes:
+ *   RB_REJECT    — puts fail (return 0 / short count) when the ring is full
+ *   RB_OVERWRITE — puts always succeed, dropping the oldest elements;
+ *                  handy for telemetry history (last N samples)
+ *
+ * Example:
+ *   rb_t(float) hist = NULL;
+ *   rb_init(hist, 64, RB_OVERWRITE);
+ *   rb_put(hist, 12.5f);
+ *   for (size_t i = 0; i < rb_count(hist); ++i)
+ *     printf("%f\n", rb_at(hist, i)); // oldest first
+ *   rb_free(hist);
+ */
+
+#ifndef RINGBUF_H
+#define RINGBUF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Optional: custom allocators */
+#ifndef RB_MALLOC
+#define RB_MALLOC malloc
+#endif
+
+#ifndef RB_FREE
+#define RB_FREE free
+#endif
+
+/* Optional: OOM handler (string describing failed op) */
+#ifndef RB_ON_OOM
+#define RB_ON_OOM(msg) abort()
+#endif
+
+typedef enum { RB_REJECT = 0, RB_OVERWRITE = 1 } rb_mode_t;
+
+/* Public type: ring of Type is rb_t(Type) */
+#define rb_t(Type) Type *
+
+/* Internal header stored immediately before the element storage */
+typedef struct {
+  size_t head; /* total elements ever written */
+  size_t tail; /* total elements ever read/dropped */
+  size_t mask; /* capacity - 1 */
+  rb_mode_t mode;
+} rb_hdr_t;
+
+/* Internal helpers */
+static inline rb_hdr_t *rb__hdr(const void *r) {
+  return r ? ((rb_hdr_t *)r) - 1 : NULL;
+}
+
+static inline size_t rb__pow2(size_t n) {
+  size_t p = 1;
+  while (p < n)
+    p <<= 1;
+  return p;
+}
+
+static inline void *rb__alloc(size_t min_cap, size_t item_size,
+                              rb_mode_t mode) {
+  size_t cap = rb__pow2(min_cap ? min_cap : 1);
+  rb_hdr_t *hdr = (rb_hdr_t *)RB_MALLOC(sizeof(rb_hdr_t) + cap * item_size);
+  if (!hdr) {
+    RB_ON_OOM("ringbuf allocation failed");
+    return NULL;
+  }
+  hdr->head = 0;
+  hdr->tail = 0;
+  hdr->mask = cap - 1;
+  hdr->mode = mode;
+  return (void *)(hdr + 1);
+}
+
+/* Claim the next write slot. Returns false when full in RB_REJECT mode.
+ * In RB_OVERWRITE mode a full ring drops its oldest element first. */
+static inline bool rb__claim(void *r) {
+  rb_hdr_t *h = rb__hdr(r);
+  if (h->head - h->tail > h->mask) {
+    if (h->mode != RB_OVERWRITE)
+      return false;
+    h->tail++;
+  }
+  h->head++;
+  return true;
+}
+
+/* Copy n elements from src into the ring; returns the number written. */
+static inline size_t rb__put_n(void *r, const void *src, size_t n,
+                               size_t item_size) {
+  if (!r || !n)
+    return 0;
+  rb_hdr_t *h = rb__hdr(r);
+  size_t cap = h->mask + 1;
+  size_t free_slots = cap - (h->head - h->tail);
+  const unsigned char *in = (const unsigned char *)src;
+
+  if (n > free_slots) {
+    if (h->mode != RB_OVERWRITE) {
+      n = free_slots;
+    } else {
+      /* Only the newest `cap` inputs can survive; skip the rest. */
+      if (n > cap) {
+        in += (n - cap) * item_size;
+        h->head += n - cap;
+        n = cap;
+      }
+      h->tail = h->head + n - cap;
+    }
+  }
+  if (!n)
+    return 0;
+
+  size_t pos = h->head & h->mask;
+  size_t first = cap - pos < n ? cap - pos : n;
+  unsigned char *base = (unsigned char *)r;
+  memcpy(base + pos * item_size, in, first * item_size);
+  if (n > first)
+    memcpy(base, in + first * item_size, (n - first) * item_size);
+  h->head += n;
+  return n;
+}
+
+/* Copy up to n oldest elements into dst without consuming them. */
+static inline size_t rb__peek_n(const void *r, void *dst, size_t n,
+                                size_t item_size) {
+  if (!r || !n)
+    return 0;
+  const rb_hdr_t *h = rb__hdr(r);
+  size_t avail = h->head - h->tail;
+  if (n > avail)
+    n = avail;
+  if (!n)
+    return 0;
+
+  size_t cap = h->mask + 1;
+  size_t pos = h->tail & h->mask;
+  size_t first = cap - pos < n ? cap - pos : n;
+  const unsigned char *base = (const unsigned char *)r;
+  unsigned char *out = (unsigned char *)dst;
+  memcpy(out, base + pos * item_size, first * item_size);
+  if (n > first)
+    memcpy(out + first * item_size, base, (n - first) * item_size);
+  return n;
+}
+
+static inline size_t rb__get_n(void *r, void *dst, size_t n,
+                               size_t item_size) {
+  n = rb__peek_n(r, dst, n, item_size);
+  if (n)
+    rb__hdr(r)->tail += n;
+  return n;
+}
+
+/* Lifecycle */
+#define rb_init(r, cap, mode)                                                  \
+  do {                                                                         \
+    (r) = rb__alloc((size_t)(cap), sizeof *(r), (mode));                       \
+  } while (0)
+
+#define rb_free(r)                                                             \
+  do {                                                                         \
+    if (r) {                                                                   \
+      RB_FREE(rb__hdr(r));                                                     \
+      (r) = NULL;                                                              \
+    }                                                                          \
+  } while (0)
+
+#define rb_clear(r)                                                            \
+  do {                                                                         \
+    if (r)                                                                     \
+      rb__hdr(r)->tail = rb__hdr(r)->head;                                     \
+  } while (0)
+
+/* Query macros */
+#define rb_count(r) ((r) ? rb__hdr(r)->head - rb__hdr(r)->tail : 0)
+#define rb_capacity(r) ((r) ? rb__hdr(r)->mask + 1 : 0)
+#define rb_empty(r) (rb_count(r) == 0)
+#define rb_full(r) ((r) && rb_count(r) == rb_capacity(r))
+
+/* Element i counted from the oldest (0) to the newest (rb_count - 1).
+ * No bounds check; usable as an lvalue. */
+#define rb_at(r, i) ((r)[(rb__hdr(r)->tail + (size_t)(i)) & rb__hdr(r)->mask])
+#define rb_front(r) rb_at(r, 0)
+#define rb_back(r) ((r)[(rb__hdr(r)->head - 1) & rb__hdr(r)->mask])
+
+/* rb_put: evaluates to true if stored. Variadic like da_push so compound
+ * literals work without extra parentheses. */
+#define rb_put(r, ...)                                                         \
+  ((r) && rb__claim(r) ? (rb_back(r) = (__VA_ARGS__), true) : false)
+
+/* rb_get: pops the oldest element into *out; evaluates to true on success. */
+#define rb_get(r, out)                                                         \
+  (rb_count(r) ? (*(out) = (r)[rb__hdr(r)->tail++ & rb__hdr(r)->mask], true)  \
+               : false)
+
+/* Bulk copies; evaluate to the number of elements transferred. */
+#define rb_put_n(r, src, n) rb__put_n((r), (src), (size_t)(n), sizeof *(r))
+#define rb_get_n(r, dst, n) rb__get_n((r), (dst), (size_t)(n), sizeof *(r))
+#define rb_peek_n(r, dst, n) rb__peek_n((r), (dst), (size_t)(n), sizeof *(r))
+
+#endif /* RINGBUF_H */
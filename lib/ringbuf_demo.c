@@ -0,0 +1,69 @@
+/*
+ * ringbuf_demo.c — demo for ringbuf.h
+ *
+ * Compile:
+ *   gcc -std=c11 ringbuf_demo.c -O2 -o ringbuf_demo
+ */
+
+#include "ringbuf.h"
+#include <assert.h>
+#include <stdio.h>
+
+typedef struct {
+  int id;
+  const char *msg;
+} event;
+
+int main(void) {
+  /* Reject mode: capacity 5 rounds up to 8 */
+  rb_t(int) q = NULL;
+  rb_init(q, 5, RB_REJECT);
+  printf("capacity = %zu\n", rb_capacity(q)); // Expected: 8
+
+  for (int i = 1; i <= 10; i++) {
+    if (!rb_put(q, i * 10))
+      printf("full, dropped %d\n", i * 10); // Expected: 90, 100
+  }
+
+  int v;
+  while (rb_get(q, &v))
+    printf("read %d\n", v);
+
+  /* Bulk put/get across the wrap point */
+  int in[6] = {1, 2, 3, 4, 5, 6}, out[8];
+  rb_put_n(q, in, 6);
+  rb_get_n(q, out, 4);
+  size_t n = rb_put_n(q, in, 6); // wraps
+  assert(n == 6 && rb_count(q) == 8);
+  n = rb_get_n(q, out, 8);
+  assert(n == 8 && out[0] == 5 && out[2] == 1 && out[7] == 6);
+  rb_free(q);
+
+  /* Overwrite mode: keep the last 4 samples */
+  rb_t(float) hist = NULL;
+  rb_init(hist, 4, RB_OVERWRITE);
+  for (int i = 0; i < 10; i++)
+    rb_put(hist, (float)i);
+  printf("history:");
+  for (size_t i = 0; i < rb_count(hist); ++i)
+    printf(" %.0f", rb_at(hist, i));
+  printf("\n"); // Expected: 6 7 8 9
+
+  float burst[7] = {10, 11, 12, 13, 14, 15, 16};
+  rb_put_n(hist, burst, 7);
+  assert(rb_count(hist) == 4 && rb_front(hist) == 13 && rb_back(hist) == 16);
+  rb_free(hist);
+
+  /* Struct elements with compound literals */
+  rb_t(event) log = NULL;
+  rb_init(log, 2, RB_OVERWRITE);
+  rb_put(log, (event){.id = 1, .msg = "boot"});
+  rb_put(log, (event){.id = 2, .msg = "login"});
+  rb_put(log, (event){.id = 3, .msg = "logout"});
+  event e;
+  while (rb_get(log, &e))
+    printf("event %d: %s\n", e.id, e.msg); // Expected: 2 login, 3 logout
+  rb_free(log);
+
+  return 0;
+}
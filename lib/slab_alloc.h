@@ -0,0 +1,339 @@
+/*
+ * slab_alloc.h — Thread-caching size-class allocator (C11, POSIX)
+ *
+ * Grown out of reusables/mempool_allocator.h: instead of one bump region
+ * with no free, memory is carved into 64 KiB spans, each span holding
+ * equal-sized blocks of one size class. Freed blocks go on intrusive free
+ * lists, so malloc/free are a pointer pop/push in the common case.
+ *
+ *   thread cache  — per-thread free list for every size class, no locks
+ *   central depot — per-class list behind a mutex; thread caches refill
+ *                   from it and spill into it in batches. A block freed on
+ *                   another thread simply lands in that thread's cache and
+ *                   flows back through the depot, and a thread's cache is
+ *                   flushed to the depot when the thread exits.
+ *
+ * Requests above SA_MAX_SMALL bytes get their own span-aligned allocation.
+ * sa_free() never needs the size: masking a pointer down to its span
+ * boundary yields the span header, which records the size class.
+ *
+ * Alignment: every block is aligned to at least 16 bytes (max_align_t on
+ * common 64-bit ABIs); sa_aligned_alloc() supports alignments up to
+ * SA_SPAN_SIZE / 2.
+ *
+ * Spans are never returned to the OS; this suits long-running processes
+ * that churn through many small objects of a stable mix of sizes.
+ *
+ * Use with dynarray.h:
+ *   #define SA_DYNARRAY_HOOKS
+ *   #include "slab_alloc.h"
+ *   #include "dynarray.h"
+ *
+ * Compile with -pthread.
+ */
+
+#ifndef SLAB_ALLOC_H
+#define SLAB_ALLOC_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Configuration */
+#define SA_SPAN_SIZE ((size_t)64 * 1024)
+#define SA_HDR_SIZE ((size_t)64) /* span header, keeps blocks 64B aligned */
+#define SA_MIN_ALIGN ((size_t)16)
+#define SA_MAX_SMALL ((size_t)8192)
+#define SA_NUM_CLASSES 32
+#define SA_LARGE_CLASS 0xFFFFu
+#define SA_SPAN_MAGIC 0x5AB5u
+
+/* Optional: OOM handler (string describing failed op) */
+#ifndef SA_ON_OOM
+#define SA_ON_OOM(msg) ((void)0)
+#endif
+
+typedef struct {
+  uint16_t magic;
+  uint16_t size_class;
+  uint32_t block_size;
+  size_t large_size; /* usable bytes, large spans only */
+} sa_span_t;
+
+typedef struct sa_block {
+  struct sa_block *next;
+} sa_block_t;
+
+typedef struct {
+  sa_block_t *head;
+  size_t count;
+} sa_list_t;
+
+typedef struct {
+  sa_list_t lists[SA_NUM_CLASSES];
+  int registered; /* thread-exit flush installed */
+} sa_tcache_t;
+
+typedef struct {
+  pthread_mutex_t lock;
+  sa_list_t list;
+} sa_depot_t;
+
+/* ========================= size classes ========================= */
+
+/* 16..128 step 16 (classes 0-7), then 4 classes per power of two up to
+ * 8192: 160, 192, 224, 256, 320, 384, 448, 512, ... */
+static inline unsigned sa__class_of(size_t size) {
+  if (size <= 128)
+    return size ? (unsigned)((size + 15) >> 4) - 1 : 0;
+  unsigned p = 63 - (unsigned)__builtin_clzll((unsigned long long)(size - 1));
+  return 8 + (p - 7) * 4 + (unsigned)((size - 1) >> (p - 2)) - 4;
+}
+
+static inline size_t sa__class_size(unsigned c) {
+  if (c < 8)
+    return (size_t)(c + 1) << 4;
+  unsigned p = 7 + (c - 8) / 4, k = (c - 8) % 4;
+  return ((size_t)1 << p) + ((size_t)(k + 1) << (p - 2));
+}
+
+/* Blocks moved between a thread cache and the depot at once */
+static inline size_t sa__batch(unsigned c) {
+  size_t n = SA_MAX_SMALL / sa__class_size(c);
+  return n < 4 ? 4 : n > 64 ? 64 : n;
+}
+
+/* ========================= global state ========================= */
+
+static sa_depot_t sa__depot[SA_NUM_CLASSES];
+static pthread_once_t sa__init_once = PTHREAD_ONCE_INIT;
+static pthread_key_t sa__exit_key;
+static _Thread_local sa_tcache_t sa__tcache;
+
+static inline sa_span_t *sa__span_of(const void *p) {
+  return (sa_span_t *)((uintptr_t)p & ~(uintptr_t)(SA_SPAN_SIZE - 1));
+}
+
+static inline void sa__push(sa_list_t *l, sa_block_t *b) {
+  b->next = l->head;
+  l->head = b;
+  l->count++;
+}
+
+/* Move up to n blocks from src to dst; returns the number moved */
+static inline size_t sa__move(sa_list_t *dst, sa_list_t *src, size_t n) {
+  size_t moved = 0;
+  while (moved < n && src->head) {
+    sa_block_t *b = src->head;
+    src->head = b->next;
+    src->count--;
+    sa__push(dst, b);
+    moved++;
+  }
+  return moved;
+}
+
+static void sa__thread_exit(void *arg) {
+  (void)arg;
+  for (unsigned c = 0; c < SA_NUM_CLASSES; c++) {
+    sa_list_t *l = &sa__tcache.lists[c];
+    if (!l->count)
+      continue;
+    pthread_mutex_lock(&sa__depot[c].lock);
+    sa__move(&sa__depot[c].list, l, l->count);
+    pthread_mutex_unlock(&sa__depot[c].lock);
+  }
+}
+
+static void sa__global_init(void) {
+  for (unsigned c = 0; c < SA_NUM_CLASSES; c++)
+    pthread_mutex_init(&sa__depot[c].lock, NULL);
+  pthread_key_create(&sa__exit_key, sa__thread_exit);
+}
+
+static void sa__register_thread(void) {
+  pthread_once(&sa__init_once, sa__global_init);
+  /* Any non-NULL value makes pthreads call the destructor at exit */
+  pthread_setspecific(sa__exit_key, &sa__tcache);
+  sa__tcache.registered = 1;
+}
+
+/* Span-aligned memory from C11 aligned_alloc, which wants the size to be
+ * a multiple of the alignment; NULL on failure */
+static void *sa__span_alloc(size_t size) {
+  if (size > SIZE_MAX - (SA_SPAN_SIZE - 1))
+    return NULL;
+  size = (size + SA_SPAN_SIZE - 1) & ~(SA_SPAN_SIZE - 1);
+  return aligned_alloc(SA_SPAN_SIZE, size);
+}
+
+/* Carve a fresh span of class c straight into the thread cache */
+static int sa__new_span(unsigned c, sa_list_t *out) {
+  void *mem = sa__span_alloc(SA_SPAN_SIZE);
+  if (!mem)
+    return 0;
+  sa_span_t *span = (sa_span_t *)mem;
+  size_t bs = sa__class_size(c);
+  span->magic = SA_SPAN_MAGIC;
+  span->size_class = (uint16_t)c;
+  span->block_size = (uint32_t)bs;
+  span->large_size = 0;
+
+  char *first = (char *)mem + SA_HDR_SIZE;
+  size_t n = (SA_SPAN_SIZE - SA_HDR_SIZE) / bs;
+  /* Push in reverse so allocation walks the span front to back */
+  for (size_t i = n; i-- > 0;)
+    sa__push(out, (sa_block_t *)(first + i * bs));
+  return 1;
+}
+
+static void *sa__refill(unsigned c) {
+  if (!sa__tcache.registered)
+    sa__register_thread();
+  sa_list_t *l = &sa__tcache.lists[c];
+
+  pthread_mutex_lock(&sa__depot[c].lock);
+  sa__move(l, &sa__depot[c].list, sa__batch(c));
+  pthread_mutex_unlock(&sa__depot[c].lock);
+
+  if (!l->head && !sa__new_span(c, l)) {
+    SA_ON_OOM("slab_alloc: span allocation failed");
+    return NULL;
+  }
+  sa_block_t *b = l->head;
+  l->head = b->next;
+  l->count--;
+  return b;
+}
+
+static void sa__spill(unsigned c) {
+  sa_list_t *l = &sa__tcache.lists[c];
+  pthread_mutex_lock(&sa__depot[c].lock);
+  sa__move(&sa__depot[c].list, l, l->count - sa__batch(c));
+  pthread_mutex_unlock(&sa__depot[c].lock);
+}
+
+static void *sa__large_alloc(size_t size, size_t align) {
+  size_t offset = SA_HDR_SIZE > align ? SA_HDR_SIZE : align;
+  if (size > SIZE_MAX - offset)
+    return NULL;
+  void *mem = sa__span_alloc(offset + size);
+  if (!mem) {
+    SA_ON_OOM("slab_alloc: large allocation failed");
+    return NULL;
+  }
+  sa_span_t *span = (sa_span_t *)mem;
+  span->magic = SA_SPAN_MAGIC;
+  span->size_class = SA_LARGE_CLASS;
+  span->block_size = 0;
+  span->large_size = size;
+  return (char *)mem + offset;
+}
+
+/* ========================= public API ========================= */
+
+static inline void *sa_malloc(size_t size) {
+  if (size > SA_MAX_SMALL)
+    return sa__large_alloc(size, SA_MIN_ALIGN);
+  unsigned c = sa__class_of(size);
+  sa_list_t *l = &sa__tcache.lists[c];
+  sa_block_t *b = l->head;
+  if (__builtin_expect(b != NULL, 1)) {
+    l->head = b->next;
+    l->count--;
+    return b;
+  }
+  return sa__refill(c);
+}
+
+static inline void sa_free(void *p) {
+  if (!p)
+    return;
+  sa_span_t *span = sa__span_of(p);
+  if (span->size_class == SA_LARGE_CLASS) {
+    free(span);
+    return;
+  }
+  unsigned c = span->size_class;
+  sa_list_t *l = &sa__tcache.lists[c];
+  sa__push(l, (sa_block_t *)p);
+  if (__builtin_expect(!sa__tcache.registered, 0))
+    sa__register_thread(); /* free-only thread: still flush at exit */
+  if (__builtin_expect(l->count > 2 * sa__batch(c), 0))
+    sa__spill(c);
+}
+
+/* Usable bytes behind p (>= the size requested) */
+static inline size_t sa_usable_size(const void *p) {
+  if (!p)
+    return 0;
+  const sa_span_t *span = sa__span_of(p);
+  return span->size_class == SA_LARGE_CLASS ? span->large_size
+                                             : span->block_size;
+}
+
+static inline void *sa_calloc(size_t n, size_t size) {
+  if (size && n > SIZE_MAX / size)
+    return NULL;
+  void *p = sa_malloc(n * size);
+  if (p)
+    memset(p, 0, n * size);
+  return p;
+}
+
+static inline void *sa_realloc(void *p, size_t size) {
+  if (!p)
+    return sa_malloc(size);
+  if (!size) {
+    sa_free(p);
+    return NULL;
+  }
+  size_t have = sa_usable_size(p);
+  /* Stay put while the request still fits the same size class */
+  if (size <= have && (have <= SA_MAX_SMALL
+                           ? sa__class_of(size) == sa__class_of(have)
+                           : size > SA_MAX_SMALL && size > have / 2))
+    return p;
+  void *q = sa_malloc(size);
+  if (q) {
+    memcpy(q, p, have < size ? have : size);
+    sa_free(p);
+  }
+  return q;
+}
+
+/* align must be a power of two no larger than SA_SPAN_SIZE / 2 */
+static inline void *sa_aligned_alloc(size_t align, size_t size) {
+  if (align <= SA_MIN_ALIGN)
+    return sa_malloc(size);
+  if (align > SA_SPAN_SIZE / 2 || (align & (align - 1)))
+    return NULL;
+  /* Power-of-two classes sit at span + 64 + i * size, so they are aligned
+   * to min(size, 64) */
+  if (align <= SA_HDR_SIZE) {
+    size_t p2 = align;
+    while (p2 < size)
+      p2 <<= 1;
+    if (p2 <= SA_MAX_SMALL)
+      return sa_malloc(p2);
+  }
+  return sa__large_alloc(size, align);
+}
+
+/* ========================= dynarray hooks ========================= */
+
+#ifdef SA_DYNARRAY_HOOKS
+#ifndef DA_MALLOC
+#define DA_MALLOC sa_malloc
+#endif
+#ifndef DA_REALLOC
+#define DA_REALLOC sa_realloc
+#endif
+#ifndef DA_FREE
+#define DA_FREE sa_free
+#endif
+#endif
+
+#endif /* SLAB_ALLOC_H */
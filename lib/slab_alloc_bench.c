@@ -0,0 +1,148 @@
+/*
+ * slab_alloc_bench.c — small-object churn: slab_alloc.h vs glibc malloc
+ *
+ * Each thread keeps a working set of live objects and repeatedly frees a
+ * random one and allocates a replacement of a random size (16..512 bytes),
+ * touching the first bytes like real code would. A second pass hands every
+ * object to a different thread before freeing it (cross-thread frees).
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 -pthread slab_alloc_bench.c -o slab_alloc_bench
+ *
+ * Run:
+ *   ./slab_alloc_bench [ops_per_thread]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "slab_alloc.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define WORKING_SET 4096
+#define MAX_THREADS 8
+
+typedef struct {
+  const char *name;
+  void *(*alloc)(size_t);
+  void (*release)(void *);
+} allocator;
+
+static const allocator allocators[] = {
+    {"glibc", malloc, free},
+    {"slab", sa_malloc, sa_free},
+};
+
+static long g_ops = 5000000;
+static const allocator *g_alloc;
+static int g_nthreads;
+static void **g_live[MAX_THREADS]; /* per-thread working sets */
+static pthread_barrier_t g_barrier;
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static inline unsigned xorshift(unsigned *s) {
+  *s ^= *s << 13;
+  *s ^= *s >> 17;
+  *s ^= *s << 5;
+  return *s;
+}
+
+static void *churn(void *arg) {
+  int id = (int)(size_t)arg;
+  unsigned seed = 2463534242u + id;
+  void **live = g_live[id];
+  for (int i = 0; i < WORKING_SET; i++) {
+    live[i] = g_alloc->alloc(16 + xorshift(&seed) % 497);
+    *(char *)live[i] = (char)i;
+  }
+  pthread_barrier_wait(&g_barrier);
+  for (long n = 0; n < g_ops; n++) {
+    unsigned r = xorshift(&seed);
+    unsigned slot = r % WORKING_SET;
+    g_alloc->release(live[slot]);
+    live[slot] = g_alloc->alloc(16 + (r >> 12) % 497);
+    *(char *)live[slot] = (char)n;
+  }
+  pthread_barrier_wait(&g_barrier);
+  return NULL;
+}
+
+/* Free the neighbour's working set, allocate it a fresh one, repeat */
+static void *cross(void *arg) {
+  int id = (int)(size_t)arg;
+  void **theirs = g_live[(id + 1) % g_nthreads];
+  pthread_barrier_wait(&g_barrier);
+  for (long n = 0; n < g_ops / WORKING_SET; n++) {
+    for (int i = 0; i < WORKING_SET; i++) {
+      g_alloc->release(theirs[i]);
+      theirs[i] = g_alloc->alloc(64);
+    }
+    pthread_barrier_wait(&g_barrier); /* owner's next round frees ours */
+  }
+  pthread_barrier_wait(&g_barrier);
+  for (int i = 0; i < WORKING_SET; i++)
+    g_alloc->release(theirs[i]);
+  return NULL;
+}
+
+/* Runs churn, then cross on the surviving working sets; returns Mops/s */
+static void run(const allocator *a, int nthreads, double *churn_rate,
+                double *cross_rate) {
+  pthread_t threads[MAX_THREADS];
+  g_alloc = a;
+  g_nthreads = nthreads;
+  pthread_barrier_init(&g_barrier, NULL, nthreads + 1);
+
+  for (int i = 0; i < nthreads; i++)
+    pthread_create(&threads[i], NULL, churn, (void *)(size_t)i);
+  pthread_barrier_wait(&g_barrier);
+  double t0 = now_sec();
+  pthread_barrier_wait(&g_barrier);
+  *churn_rate = (double)nthreads * g_ops / (now_sec() - t0) / 1e6;
+  for (int i = 0; i < nthreads; i++)
+    pthread_join(threads[i], NULL);
+
+  for (int i = 0; i < nthreads; i++)
+    pthread_create(&threads[i], NULL, cross, (void *)(size_t)i);
+  t0 = now_sec();
+  pthread_barrier_wait(&g_barrier);
+  for (long n = 0; n < g_ops / WORKING_SET; n++)
+    pthread_barrier_wait(&g_barrier);
+  pthread_barrier_wait(&g_barrier);
+  long rounds = g_ops / WORKING_SET;
+  *cross_rate =
+      (double)nthreads * rounds * WORKING_SET / (now_sec() - t0) / 1e6;
+  for (int i = 0; i < nthreads; i++)
+    pthread_join(threads[i], NULL);
+  pthread_barrier_destroy(&g_barrier);
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1)
+    g_ops = atol(argv[1]);
+  for (int i = 0; i < MAX_THREADS; i++)
+    g_live[i] = calloc(WORKING_SET, sizeof(void *));
+
+  printf("%ld free+malloc pairs per thread, Mops/s (higher is better)\n",
+         g_ops);
+  printf("churn: own objects; cross: objects allocated by another thread\n\n");
+  printf("%8s %12s %12s %12s %12s\n", "threads", "glibc churn", "slab churn",
+         "glibc cross", "slab cross");
+  for (int n = 1; n <= MAX_THREADS; n *= 2) {
+    double churn_rate[2], cross_rate[2];
+    for (int a = 0; a < 2; a++)
+      run(&allocators[a], n, &churn_rate[a], &cross_rate[a]);
+    printf("%8d %12.1f %12.1f %12.1f %12.1f\n", n, churn_rate[0],
+           churn_rate[1], cross_rate[0], cross_rate[1]);
+  }
+
+  for (int i = 0; i < MAX_THREADS; i++)
+    free(g_live[i]);
+  return 0;
+}
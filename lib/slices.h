@@ -2,6 +2,8 @@
 #define SLICES_H
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 /*
@@ -24,7 +26,7 @@ typedef int (*slice_cmp_fn)(const void *, const void *);
     (slice(typeof(*(arr)))){ (arr), (count) }
 #define slice_from_ptr(ptr, count) \
     (slice(typeof(*(ptr)))){ (ptr), (count) }
-#define slice_empty(T) \
+#define slice_empty_of(T) \
     (slice(T)){ NULL, 0 }
 
 // Accessors
@@ -148,4 +150,308 @@ typedef slice(char) str_slice;
         _str; \
     })
 
+/*
+ * String slice toolkit - tokenizing and parsing without copies
+ *
+ * Every function takes and returns views into the caller's buffer: nothing
+ * allocates and nothing needs a NUL terminator, so config lines, CSV fields
+ * and command lines can be split and parsed in place.
+ *
+ * str_slice line = str_slice_of("  speed = 2.5  ");
+ * str_slice key, val;
+ * double speed;
+ * if (str_slice_split_once(line, '=', &key, &val) &&
+ *     str_slice_parse_f64(str_slice_trim(val), &speed)) ...
+ *
+ * str_split_t it = str_split(str_slice_of("a,b,,c"), ',');
+ * str_slice tok;
+ * while (str_split_next(&it, &tok)) ... // "a" "b" "" "c"
+ *
+ * Not-found results are reported as s.len, like slice_find. Byte scans go
+ * through memchr; whitespace and separator-set scans use SSE2 (define
+ * SLICES_NO_SIMD for the scalar fallback).
+ */
+
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(SLICES_NO_SIMD)
+#define SLICES__SIMD 1
+#include <emmintrin.h>
+#endif
+
+// Separator sets up to this size are matched 16 bytes at a time
+#define SLICES__SIMD_SET_MAX 8
+
+#define STR_SLICE_WHITESPACE " \t\r\n\v\f"
+
+// View of a C string or const buffer (str_slice's ptr is not const)
+static inline str_slice str_slice_make(const char *ptr, size_t len) {
+    return (str_slice){ (char *)ptr, len };
+}
+
+static inline str_slice str_slice_of(const char *cstr) {
+    return str_slice_make(cstr, strlen(cstr));
+}
+
+static inline bool str_slice_eq_cstr(str_slice s, const char *cstr) {
+    size_t n = strlen(cstr);
+    return s.len == n && memcmp(s.ptr, cstr, n) == 0;
+}
+
+static inline bool str_slice_starts_with(str_slice s, str_slice prefix) {
+    return s.len >= prefix.len && memcmp(s.ptr, prefix.ptr, prefix.len) == 0;
+}
+
+static inline bool str_slice_ends_with(str_slice s, str_slice suffix) {
+    return s.len >= suffix.len &&
+           memcmp(s.ptr + s.len - suffix.len, suffix.ptr, suffix.len) == 0;
+}
+
+// Searching
+
+static inline size_t str_slice_find_byte(str_slice s, char c) {
+    if (s.len == 0)
+        return 0;
+    const char *p = (const char *)memchr(s.ptr, c, s.len);
+    return p ? (size_t)(p - s.ptr) : s.len;
+}
+
+static inline size_t str_slice_rfind_byte(str_slice s, char c) {
+    for (size_t i = s.len; i-- > 0;)
+        if (s.ptr[i] == c)
+            return i;
+    return s.len;
+}
+
+// First byte that is any of the bytes in `set` (a C string)
+static inline size_t str_slice_find_any(str_slice s, const char *set) {
+    size_t nset = strlen(set), i = 0;
+    if (nset == 0)
+        return s.len;
+    if (nset == 1)
+        return str_slice_find_byte(s, set[0]);
+#ifdef SLICES__SIMD
+    if (nset <= SLICES__SIMD_SET_MAX) {
+        __m128i needle[SLICES__SIMD_SET_MAX];
+        for (size_t k = 0; k < nset; k++)
+            needle[k] = _mm_set1_epi8(set[k]);
+        for (; i + 16 <= s.len; i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(s.ptr + i));
+            __m128i m = _mm_cmpeq_epi8(v, needle[0]);
+            for (size_t k = 1; k < nset; k++)
+                m = _mm_or_si128(m, _mm_cmpeq_epi8(v, needle[k]));
+            int bits = _mm_movemask_epi8(m);
+            if (bits)
+                return i + (size_t)__builtin_ctz((unsigned)bits);
+        }
+        for (; i < s.len; i++)
+            if (s.ptr[i] && memchr(set, s.ptr[i], nset))
+                return i;
+        return s.len;
+    }
+#endif
+    uint8_t member[256] = { 0 };
+    for (size_t k = 0; k < nset; k++)
+        member[(unsigned char)set[k]] = 1;
+    for (; i < s.len; i++)
+        if (member[(unsigned char)s.ptr[i]])
+            return i;
+    return s.len;
+}
+
+static inline bool str__is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// First whitespace byte (STR_SLICE_WHITESPACE); two compares per 16 bytes
+static inline size_t str_slice_find_space(str_slice s) {
+    size_t i = 0;
+#ifdef SLICES__SIMD
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t'), four = _mm_set1_epi8(4);
+    for (; i + 16 <= s.len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s.ptr + i));
+        __m128i ctl = _mm_sub_epi8(v, tab); // '\t'..'\r' -> 0..4
+        __m128i m = _mm_or_si128(
+            _mm_cmpeq_epi8(v, space),
+            _mm_cmpeq_epi8(_mm_min_epu8(ctl, four), ctl));
+        int bits = _mm_movemask_epi8(m);
+        if (bits)
+            return i + (size_t)__builtin_ctz((unsigned)bits);
+    }
+#endif
+    for (; i < s.len; i++)
+        if (str__is_space(s.ptr[i]))
+            return i;
+    return s.len;
+}
+
+// Substring search: memchr to the next candidate first byte, then memcmp
+static inline size_t str_slice_find(str_slice s, str_slice needle) {
+    if (needle.len == 0)
+        return 0;
+    if (needle.len > s.len)
+        return s.len;
+    const char *p = s.ptr, *last = s.ptr + s.len - needle.len;
+    while (p <= last) {
+        p = (const char *)memchr(p, needle.ptr[0], (size_t)(last - p) + 1);
+        if (!p)
+            break;
+        if (memcmp(p + 1, needle.ptr + 1, needle.len - 1) == 0)
+            return (size_t)(p - s.ptr);
+        p++;
+    }
+    return s.len;
+}
+
+static inline bool str_slice_contains(str_slice s, str_slice needle) {
+    return needle.len == 0 || str_slice_find(s, needle) < s.len;
+}
+
+// Trimming
+
+static inline str_slice str_slice_trim_left(str_slice s) {
+    while (s.len && str__is_space(*s.ptr)) {
+        s.ptr++;
+        s.len--;
+    }
+    return s;
+}
+
+static inline str_slice str_slice_trim_right(str_slice s) {
+    while (s.len && str__is_space(s.ptr[s.len - 1]))
+        s.len--;
+    return s;
+}
+
+static inline str_slice str_slice_trim(str_slice s) {
+    return str_slice_trim_right(str_slice_trim_left(s));
+}
+
+// Split at the first `sep`: "key=value" -> "key", "value".
+// Returns false (and leaves left/right untouched) if sep is absent.
+static inline bool str_slice_split_once(str_slice s, char sep,
+                                        str_slice *left, str_slice *right) {
+    size_t i = str_slice_find_byte(s, sep);
+    if (i == s.len)
+        return false;
+    *left = (str_slice){ s.ptr, i };
+    *right = (str_slice){ s.ptr + i + 1, s.len - i - 1 };
+    return true;
+}
+
+// Split iterators
+
+typedef enum {
+    STR_SPLIT_BYTE,  // on one separator byte, empty fields kept
+    STR_SPLIT_ANY,   // on any byte of a set, empty fields kept
+    STR_SPLIT_WORDS, // on whitespace runs, no empty tokens
+} str_split_mode;
+
+typedef struct {
+    str_slice rest;
+    const char *set; // STR_SPLIT_ANY separators
+    char sep;        // STR_SPLIT_BYTE separator
+    str_split_mode mode;
+    bool done;
+} str_split_t;
+
+// Every field, empty ones included: "a,,b" -> "a" "" "b"
+static inline str_split_t str_split(str_slice s, char sep) {
+    return (str_split_t){ s, NULL, sep, STR_SPLIT_BYTE, false };
+}
+
+// Split on any byte of `set` (kept by pointer, must outlive the iterator)
+static inline str_split_t str_split_any(str_slice s, const char *set) {
+    return (str_split_t){ s, set, 0, STR_SPLIT_ANY, false };
+}
+
+// Whitespace-separated words: " ls  -l " -> "ls" "-l"
+static inline str_split_t str_split_words(str_slice s) {
+    return (str_split_t){ s, NULL, 0, STR_SPLIT_WORDS, false };
+}
+
+static inline bool str_split_next(str_split_t *it, str_slice *tok) {
+    if (it->done)
+        return false;
+    size_t i;
+    switch (it->mode) {
+    case STR_SPLIT_WORDS:
+        it->rest = str_slice_trim_left(it->rest);
+        if (it->rest.len == 0) {
+            it->done = true;
+            return false;
+        }
+        i = str_slice_find_space(it->rest);
+        break;
+    case STR_SPLIT_ANY:
+        i = str_slice_find_any(it->rest, it->set);
+        break;
+    default:
+        i = str_slice_find_byte(it->rest, it->sep);
+        break;
+    }
+    *tok = (str_slice){ it->rest.ptr, i };
+    if (i == it->rest.len) {
+        it->done = true;
+    } else {
+        it->rest.ptr += i + 1;
+        it->rest.len -= i + 1;
+    }
+    return true;
+}
+
+// Numeric parsing: the whole slice must be the number (no surrounding
+// spaces, no trailing junk); *out is only written on success.
+
+static inline bool str__parse_digits(str_slice s, uint64_t limit,
+                                     uint64_t *out) {
+    if (s.len == 0 || s.len > 20)
+        return false;
+    uint64_t v = 0;
+    for (size_t i = 0; i < s.len; i++) {
+        unsigned d = (unsigned)(unsigned char)s.ptr[i] - '0';
+        if (d > 9)
+            return false;
+        // 19 digits always fit in 64 bits; only the 20th can overflow
+        if (i == 19 && v > (UINT64_MAX - d) / 10)
+            return false;
+        v = v * 10 + d;
+    }
+    if (v > limit)
+        return false;
+    *out = v;
+    return true;
+}
+
+static inline bool str_slice_parse_u64(str_slice s, uint64_t *out) {
+    if (s.len && s.ptr[0] == '+')
+        s = (str_slice){ s.ptr + 1, s.len - 1 };
+    return str__parse_digits(s, UINT64_MAX, out);
+}
+
+static inline bool str_slice_parse_i64(str_slice s, int64_t *out) {
+    bool neg = s.len && s.ptr[0] == '-';
+    if (s.len && (s.ptr[0] == '-' || s.ptr[0] == '+'))
+        s = (str_slice){ s.ptr + 1, s.len - 1 };
+    uint64_t mag;
+    if (!str__parse_digits(s, neg ? (uint64_t)INT64_MAX + 1 : INT64_MAX, &mag))
+        return false;
+    *out = neg ? (int64_t)(0 - mag) : (int64_t)mag;
+    return true;
+}
+
+// Anything strtod accepts, copied through a stack buffer (max 63 chars)
+static inline bool str_slice_parse_f64(str_slice s, double *out) {
+    char buf[64];
+    if (s.len == 0 || s.len >= sizeof buf || str__is_space(s.ptr[0]))
+        return false;
+    memcpy(buf, s.ptr, s.len);
+    buf[s.len] = '\0';
+    char *end;
+    double v = strtod(buf, &end);
+    if (end != buf + s.len)
+        return false;
+    *out = v;
+    return true;
+}
+
 #endif /* SLICES_H */
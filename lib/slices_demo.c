@@ -20,7 +20,7 @@ int main() {
     printf("\n"); // Expected: 2 3
 
     // Test empty slice
-    slice(int) empty = slice_empty(int);
+    slice(int) empty = slice_empty_of(int);
     printf("Empty first: %d\n", slice_first(empty, -1)); // Expected: -1
 
     // Test comparison
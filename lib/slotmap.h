@@ -0,0 +1,183 @@
+/*
+ * slotmap.h — Slot map with generational handles, built on dynarray.h
+ *
+ * Pointers into a da_t dangle as soon as it grows, and indices shift when
+ * an element is removed. A slot map hands out 32-bit handles instead:
+ *
+ *   handle = generation << SM_INDEX_BITS | slot index
+ *
+ * The slot records where the element currently sits in a dense, packed
+ * da_t of values, and its generation is bumped on every removal, so a
+ * handle to a removed element simply stops resolving (sm_get -> NULL)
+ * instead of aliasing whatever reuses the slot. Insert, remove and lookup
+ * are O(1); iteration walks the dense array with no holes.
+ *
+ *   sm_t(Particle) ps = {0};
+ *   sm_handle_t h;
+ *   sm_insert(ps, h, (Particle){.speed = 2});
+ *   Particle *p = sm_get(ps, h);            // NULL once removed
+ *   for (size_t i = 0; i < sm_count(ps); i++)
+ *     update(&ps.data[i]);                  // dense, cache-friendly
+ *   sm_remove(ps, h);
+ *   sm_free(ps);
+ *
+ * Removal moves the last element into the hole (like da_remove_fast), so
+ * dense order is not stable and pointers into .data are only valid until
+ * the next insert or remove; keep handles, not pointers.
+ *
+ * A slot whose generation would wrap around is retired rather than
+ * reused, so a stale handle can never match a new element.
+ */
+
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include "dynarray.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Configuration: index bits + generation bits = 32 */
+#ifndef SM_INDEX_BITS
+#define SM_INDEX_BITS 20 /* up to 1M live elements */
+#endif
+
+#define SM_MAX_SLOTS ((uint32_t)1 << SM_INDEX_BITS)
+#define SM_INDEX_MASK (SM_MAX_SLOTS - 1)
+#define SM_GEN_MASK ((uint32_t)0xFFFFFFFFu >> SM_INDEX_BITS)
+
+typedef uint32_t sm_handle_t;
+
+/* Never returned by sm_insert (generations start at 1) */
+#define SM_NULL_HANDLE ((sm_handle_t)0)
+
+typedef struct {
+  uint32_t dense; /* position in .data while live, next free slot + 1 if not */
+  uint32_t gen;   /* 0 only for retired slots */
+} sm_slot_t;
+
+/* Bookkeeping shared by every sm_t(Type) */
+typedef struct {
+  uint32_t *dense_slot; /* da_t: slot index of each dense element */
+  sm_slot_t *slots;     /* da_t */
+  uint32_t free_head;   /* free slot + 1, 0 = none; zero-init is valid */
+} sm_index_t;
+
+/* Public type: slot map of Type. Zero-initialize it ({0}) before use. */
+#define sm_t(Type)                                                             \
+  struct {                                                                     \
+    Type *data; /* dense da_t of values */                                     \
+    sm_index_t idx;                                                            \
+  }
+
+/* ========================= internals ========================= */
+
+static inline sm_handle_t sm__make(uint32_t slot, uint32_t gen) {
+  return (gen << SM_INDEX_BITS) | slot;
+}
+
+/* Dense position of h, or UINT32_MAX if h is stale / invalid */
+static inline uint32_t sm__lookup(const sm_index_t *x, sm_handle_t h) {
+  uint32_t slot = h & SM_INDEX_MASK, gen = h >> SM_INDEX_BITS;
+  if (slot >= da_count(x->slots) || gen == 0 || x->slots[slot].gen != gen)
+    return UINT32_MAX;
+  return x->slots[slot].dense;
+}
+
+/* Claim a slot for a value about to be pushed at dense position `dense` */
+static inline sm_handle_t sm__acquire(sm_index_t *x, size_t dense) {
+  uint32_t slot;
+  if (x->free_head) {
+    slot = x->free_head - 1;
+    x->free_head = x->slots[slot].dense;
+  } else {
+    if (da_count(x->slots) >= SM_MAX_SLOTS)
+      return SM_NULL_HANDLE;
+    slot = (uint32_t)da_count(x->slots);
+    da_push(x->slots, ((sm_slot_t){0, 1}));
+  }
+  x->slots[slot].dense = (uint32_t)dense;
+  da_push(x->dense_slot, slot);
+  return sm__make(slot, x->slots[slot].gen);
+}
+
+/* Free h's slot and patch the bookkeeping for a swap-with-last removal of
+ * the dense array. Returns the dense position to remove, or UINT32_MAX. */
+static inline uint32_t sm__release(sm_index_t *x, sm_handle_t h) {
+  uint32_t d = sm__lookup(x, h);
+  if (d == UINT32_MAX)
+    return d;
+  uint32_t slot = h & SM_INDEX_MASK;
+  uint32_t last = (uint32_t)da_count(x->dense_slot) - 1;
+  uint32_t moved = x->dense_slot[last];
+  x->dense_slot[d] = moved;
+  x->slots[moved].dense = d;
+  da__hdr(x->dense_slot)->count--;
+
+  sm_slot_t *s = &x->slots[slot];
+  s->gen = (s->gen + 1) & SM_GEN_MASK;
+  if (s->gen) { /* retire the slot instead of wrapping to a reused gen */
+    s->dense = x->free_head;
+    x->free_head = slot + 1;
+  }
+  return d;
+}
+
+/* ========================= public API ========================= */
+
+#define sm_count(m) da_count((m).data)
+
+/* Insert a value; h receives its handle (SM_NULL_HANDLE if the map is full).
+ * Variadic like da_push so compound literals need no extra parentheses. */
+#define sm_insert(m, h, ...)                                                   \
+  do {                                                                         \
+    (h) = sm__acquire(&(m).idx, da_count((m).data));                           \
+    if ((h) != SM_NULL_HANDLE)                                                 \
+      da_push((m).data, (__VA_ARGS__));                                        \
+  } while (0)
+
+/* Pointer to the element for h, or NULL if it was removed. Valid until the
+ * next insert / remove. (h is evaluated twice.) */
+#define sm_get(m, h)                                                           \
+  (sm__lookup(&(m).idx, (h)) != UINT32_MAX                                     \
+       ? (m).data + (m).idx.slots[(h) & SM_INDEX_MASK].dense                   \
+       : NULL)
+
+#define sm_contains(m, h) (sm__lookup(&(m).idx, (h)) != UINT32_MAX)
+
+/* Remove the element for h (no-op for a stale handle) */
+#define sm_remove(m, h)                                                        \
+  do {                                                                         \
+    uint32_t __d = sm__release(&(m).idx, (h));                                 \
+    if (__d != UINT32_MAX)                                                     \
+      da_remove_fast((m).data, __d);                                           \
+  } while (0)
+
+/* Handle of the element at dense position i (for iterate-and-remove) */
+#define sm_handle_at(m, i)                                                     \
+  sm__make((m).idx.dense_slot[(i)],                                            \
+           (m).idx.slots[(m).idx.dense_slot[(i)]].gen)
+
+#define sm_reserve(m, n)                                                       \
+  do {                                                                         \
+    da_reserve((m).data, (n));                                                 \
+    da_reserve((m).idx.dense_slot, (n));                                       \
+    da_reserve((m).idx.slots, (n));                                            \
+  } while (0)
+
+/* Remove everything; all outstanding handles become stale */
+#define sm_clear(m)                                                            \
+  do {                                                                         \
+    while (sm_count(m))                                                        \
+      sm_remove(m, sm_handle_at(m, sm_count(m) - 1));                          \
+  } while (0)
+
+#define sm_free(m)                                                             \
+  do {                                                                         \
+    da_free((m).data);                                                         \
+    da_free((m).idx.dense_slot);                                               \
+    da_free((m).idx.slots);                                                    \
+    (m).idx.free_head = 0;                                                     \
+  } while (0)
+
+#endif /* SLOTMAP_H */
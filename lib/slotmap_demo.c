@@ -0,0 +1,76 @@
+/*
+ * slotmap_demo.c — demo for slotmap.h
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 slotmap_demo.c -o slotmap_demo
+ */
+
+#include "slotmap.h"
+#include <assert.h>
+#include <stdio.h>
+
+typedef struct {
+  float x, y;
+  int ttl;
+} particle;
+
+typedef struct {
+  sm_handle_t target; /* handle, not a pointer: survives growth */
+  const char *name;
+} follower;
+
+int main(void) {
+  sm_t(particle) particles = {0};
+
+  /* Insert and look up */
+  sm_handle_t a, b, c;
+  sm_insert(particles, a, (particle){1, 1, 3});
+  sm_insert(particles, b, (particle){2, 2, 1});
+  sm_insert(particles, c, (particle){3, 3, 2});
+  assert(sm_count(particles) == 3);
+  assert(sm_get(particles, b) != NULL);
+
+  follower f = {b, "camera"};
+
+  /* Grow far past the initial capacity: handles stay valid where a
+   * pointer into a da_t would have dangled after the realloc */
+  for (int i = 0; i < 10000; i++) {
+    sm_handle_t h;
+    sm_insert(particles, h, (particle){(float)i, 0, 5});
+  }
+  particle *target = sm_get(particles, f.target);
+  printf("%s follows (%.0f, %.0f)\n", f.name, target->x, target->y);
+  // Expected: camera follows (2, 2)
+
+  /* Iterate densely, removing expired particles by handle */
+  for (size_t i = 0; i < sm_count(particles);) {
+    if (--particles.data[i].ttl == 0)
+      sm_remove(particles, sm_handle_at(particles, i)); /* last moves to i */
+    else
+      i++;
+  }
+  assert(sm_count(particles) == 10002);
+
+  /* b expired: its handle no longer resolves */
+  printf("camera target alive: %s\n",
+         sm_contains(particles, f.target) ? "yes" : "no");
+  // Expected: camera target alive: no
+
+  /* The freed slot is reused with a new generation, so the old handle
+   * does not alias the new element */
+  sm_handle_t d;
+  sm_insert(particles, d, (particle){9, 9, 1});
+  assert((d & SM_INDEX_MASK) == (b & SM_INDEX_MASK) && d != b);
+  assert(!sm_contains(particles, b) && sm_contains(particles, d));
+
+  sm_remove(particles, a);
+  sm_remove(particles, a); /* stale: no-op */
+  assert(sm_get(particles, c)->x == 3);
+
+  sm_clear(particles);
+  assert(sm_count(particles) == 0 && !sm_contains(particles, c));
+  sm_free(particles);
+  printf("ok\n");
+  // Expected: ok
+  return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * soa.h — Structure-of-arrays container generator (C11)
+ *
+ * One macro defines a row struct and a matching SoA container that keeps
+ * every field in its own column, so a loop that only reads position and
+ * speed never pulls color through the cache:
+ *
+ *   soa_define(Particle, (Vector2, position), (Color, color), (float, speed))
+ *
+ * expands to
+ *
+ *   typedef struct Particle { Vector2 position; Color color; float speed; }
+ *       Particle;
+ *   typedef struct { size_t count, capacity; ...;
+ *                    Vector2 *position; Color *color; float *speed; }
+ *       Particle_soa;
+ *
+ * plus Particle_soa_init / _free / _clear / _reserve / _push / _get / _set /
+ * _remove / _remove_fast. Usage:
+ *
+ *   Particle_soa ps;
+ *   Particle_soa_init(&ps);
+ *   Particle_soa_push(&ps, (Particle){pos, RED, 2.0f});
+ *   soa_foreach(ps, i) {
+ *     ps.position[i].x += ps.speed[i];
+ *   }
+ *   Particle_soa_free(&ps);
+ *
+ * All columns share one allocation and each starts on an SOA_ALIGN (64)
+ * byte boundary, so column loops can use aligned vector loads; wrap a
+ * column in soa_assume_aligned() to let the compiler know. Up to 16 fields.
+ */
+
+#ifndef SOA_H
+#define SOA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Configuration */
+#ifndef SOA_ALIGN
+#define SOA_ALIGN 64 /* cache line; also enough for AVX-512 loads */
+#endif
+
+#ifndef SOA_INIT_CAPACITY
+#define SOA_INIT_CAPACITY 64
+#endif
+
+/* Optional: custom allocators (size is a multiple of SOA_ALIGN) */
+#ifndef SOA_ALIGNED_ALLOC
+#define SOA_ALIGNED_ALLOC(align, size) aligned_alloc((align), (size))
+#endif
+
+#ifndef SOA_FREE
+#define SOA_FREE free
+#endif
+
+/* Optional: OOM handler (string describing failed op) */
+#ifndef SOA_ON_OOM
+#define SOA_ON_OOM(msg) abort()
+#endif
+
+#if defined(__GNUC__)
+#define soa_assume_aligned(p) __builtin_assume_aligned((p), SOA_ALIGN)
+#else
+#define soa_assume_aligned(p) (p)
+#endif
+
+#define soa_foreach(s, i) for (size_t i = 0; i < (s).count; i++)
+
+/* Bytes a column of n elements occupies, padded to the next boundary */
+static inline size_t soa__column_bytes(size_t n, size_t elem_size) {
+  return (n * elem_size + SOA_ALIGN - 1) & ~(size_t)(SOA_ALIGN - 1);
+}
+
+/* ========================= field-list plumbing ========================= */
+
+#define SOA__CAT(a, b) SOA__CAT_(a, b)
+#define SOA__CAT_(a, b) a##b
+
+#define SOA__NARGS(...)                                                        \
+  SOA__NARGS_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, \
+              1, 0)
+#define SOA__NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13,    \
+                    _14, _15, _16, N, ...)                                     \
+  N
+
+/* SOA__MAP(m, (T1, f1), (T2, f2), ...) -> m((T1, f1)) m((T2, f2)) ... */
+#define SOA__MAP(m, ...)                                                       \
+  SOA__CAT(SOA__MAP_, SOA__NARGS(__VA_ARGS__))(m, __VA_ARGS__)
+#define SOA__MAP_1(m, x) m(x)
+#define SOA__MAP_2(m, x, ...) m(x) SOA__MAP_1(m, __VA_ARGS__)
+#define SOA__MAP_3(m, x, ...) m(x) SOA__MAP_2(m, __VA_ARGS__)
+#define SOA__MAP_4(m, x, ...) m(x) SOA__MAP_3(m, __VA_ARGS__)
+#define SOA__MAP_5(m, x, ...) m(x) SOA__MAP_4(m, __VA_ARGS__)
+#define SOA__MAP_6(m, x, ...) m(x) SOA__MAP_5(m, __VA_ARGS__)
+#define SOA__MAP_7(m, x, ...) m(x) SOA__MAP_6(m, __VA_ARGS__)
+#define SOA__MAP_8(m, x, ...) m(x) SOA__MAP_7(m, __VA_ARGS__)
+#define SOA__MAP_9(m, x, ...) m(x) SOA__MAP_8(m, __VA_ARGS__)
+#define SOA__MAP_10(m, x, ...) m(x) SOA__MAP_9(m, __VA_ARGS__)
+#define SOA__MAP_11(m, x, ...) m(x) SOA__MAP_10(m, __VA_ARGS__)
+#define SOA__MAP_12(m, x, ...) m(x) SOA__MAP_11(m, __VA_ARGS__)
+#define SOA__MAP_13(m, x, ...) m(x) SOA__MAP_12(m, __VA_ARGS__)
+#define SOA__MAP_14(m, x, ...) m(x) SOA__MAP_13(m, __VA_ARGS__)
+#define SOA__MAP_15(m, x, ...) m(x) SOA__MAP_14(m, __VA_ARGS__)
+#define SOA__MAP_16(m, x, ...) m(x) SOA__MAP_15(m, __VA_ARGS__)
+
+/* Per-field snippets; each receives a (Type, name) pair */
+#define SOA__ROW_FIELD(p) SOA__ROW_FIELD_ p
+#define SOA__ROW_FIELD_(T, f) T f;
+#define SOA__COLUMN(p) SOA__COLUMN_ p
+#define SOA__COLUMN_(T, f) T *f;
+#define SOA__BYTES(p) SOA__BYTES_ p
+#define SOA__BYTES_(T, f) total += soa__column_bytes(cap, sizeof(T));
+#define SOA__MOVE(p) SOA__MOVE_ p
+#define SOA__MOVE_(T, f)                                                       \
+  if (s->count)                                                                \
+    memcpy(blk + off, s->f, s->count * sizeof(T));                             \
+  s->f = (T *)(void *)(blk + off);                                             \
+  off += soa__column_bytes(cap, sizeof(T));
+#define SOA__STORE(p) SOA__STORE_ p
+#define SOA__STORE_(T, f) s->f[i] = v.f;
+#define SOA__LOAD(p) SOA__LOAD_ p
+#define SOA__LOAD_(T, f) r.f = s->f[i];
+#define SOA__SWAP_LAST(p) SOA__SWAP_LAST_ p
+#define SOA__SWAP_LAST_(T, f) s->f[i] = s->f[last];
+#define SOA__SHIFT(p) SOA__SHIFT_ p
+#define SOA__SHIFT_(T, f)                                                      \
+  memmove(s->f + i, s->f + i + 1, (s->count - i - 1) * sizeof(T));
+
+/* ========================= generator ========================= */
+
+#define soa_define(Name, ...)                                                  \
+  typedef struct Name {                                                        \
+    SOA__MAP(SOA__ROW_FIELD, __VA_ARGS__)                                      \
+  } Name;                                                                      \
+                                                                               \
+  typedef struct {                                                             \
+    size_t count;                                                              \
+    size_t capacity;                                                           \
+    unsigned char *block; /* all columns, SOA_ALIGN-aligned */                 \
+    SOA__MAP(SOA__COLUMN, __VA_ARGS__)                                         \
+  } Name##_soa;                                                                \
+                                                                               \
+  static inline void Name##_soa_init(Name##_soa *s) {                          \
+    memset(s, 0, sizeof *s);                                                   \
+  }                                                                            \
+                                                                               \
+  static inline void Name##_soa_free(Name##_soa *s) {                          \
+    SOA_FREE(s->block);                                                        \
+    memset(s, 0, sizeof *s);                                                   \
+  }                                                                            \
+                                                                               \
+  static inline void Name##_soa_clear(Name##_soa *s) { s->count = 0; }         \
+                                                                               \
+  static inline bool Name##_soa_reserve(Name##_soa *s, size_t want) {          \
+    if (want <= s->capacity)                                                   \
+      return true;                                                             \
+    size_t cap = s->capacity ? s->capacity * 2 : SOA_INIT_CAPACITY;            \
+    if (cap < want)                                                            \
+      cap = want;                                                              \
+    size_t total = 0;                                                          \
+    SOA__MAP(SOA__BYTES, __VA_ARGS__)                                          \
+    unsigned char *blk =                                                       \
+        (unsigned char *)SOA_ALIGNED_ALLOC(SOA_ALIGN, total);                  \
+    if (!blk) {                                                                \
+      SOA_ON_OOM("soa column allocation failed");                              \
+      return false;                                                            \
+    }                                                                          \
+    size_t off = 0;                                                            \
+    SOA__MAP(SOA__MOVE, __VA_ARGS__)                                           \
+    (void)off;                                                                 \
+    SOA_FREE(s->block);                                                        \
+    s->block = blk;                                                            \
+    s->capacity = cap;                                                         \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  static inline bool Name##_soa_push(Name##_soa *s, Name v) {                  \
+    if (s->count == s->capacity && !Name##_soa_reserve(s, s->count + 1))       \
+      return false;                                                            \
+    size_t i = s->count++;                                                     \
+    SOA__MAP(SOA__STORE, __VA_ARGS__)                                          \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Gather row i into a struct (i < count) */                                 \
+  static inline Name Name##_soa_get(const Name##_soa *s, size_t i) {           \
+    Name r;                                                                    \
+    SOA__MAP(SOA__LOAD, __VA_ARGS__)                                           \
+    return r;                                                                  \
+  }                                                                            \
+                                                                               \
+  static inline void Name##_soa_set(Name##_soa *s, size_t i, Name v) {         \
+    SOA__MAP(SOA__STORE, __VA_ARGS__)                                          \
+  }                                                                            \
+                                                                               \
+  /* Unordered O(1) remove: row `last` moves into i */                         \
+  static inline void Name##_soa_remove_fast(Name##_soa *s, size_t i) {         \
+    if (i >= s->count)                                                         \
+      return;                                                                  \
+    size_t last = --s->count;                                                  \
+    SOA__MAP(SOA__SWAP_LAST, __VA_ARGS__)                                      \
+  }                                                                            \
+                                                                               \
+  /* Order-preserving O(n) remove */                                           \
+  static inline void Name##_soa_remove(Name##_soa *s, size_t i) {              \
+    if (i >= s->count)                                                         \
+      return;                                                                  \
+    SOA__MAP(SOA__SHIFT, __VA_ARGS__)                                          \
+    s->count--;                                                                \
+  }
+
+#endif /* SOA_H */
@@ -0,0 +1,157 @@
+/*
+ * soa_bench.c — AoS vs SoA on the particles_reactive.c update loop
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 soa_bench.c -lm -o soa_bench
+ *   gcc -std=c11 -O3 -fno-math-errno -fno-trapping-math soa_bench.c -lm \
+ *       -o soa_bench
+ *
+ * Every frame each particle steps towards a target at its own speed; the
+ * loop reads position + speed and writes position, color is never touched.
+ *   aos        — Particle[]: {Vector2 position; Color color; float speed;}
+ *   soa        — soa_define(Particle, (Vector2, position), (Color, color),
+ *                (float, speed)): color stays out of the cache
+ *   soa split  — x and y as separate float columns, which lets the compiler
+ *                vectorize the loop (needs -O3 -fno-math-errno
+ *                -fno-trapping-math; at -O2 it stays scalar)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "soa.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#define N (1 << 20)
+#define FRAMES 200
+
+typedef struct {
+  float x, y;
+} Vector2;
+
+typedef struct {
+  unsigned char r, g, b, a;
+} Color;
+
+typedef struct {
+  Vector2 position;
+  Color color;
+  float speed;
+} ParticleAoS;
+
+soa_define(Particle, (Vector2, position), (Color, color), (float, speed))
+
+soa_define(ParticleSplit, (float, x), (float, y), (Color, color),
+           (float, speed))
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static inline float rnd(unsigned *s) {
+  *s = *s * 1664525u + 1013904223u;
+  return (float)(*s >> 8) / (float)(1u << 24);
+}
+
+static inline Vector2 step(Vector2 p, float speed, Vector2 t) {
+  float dx = t.x - p.x, dy = t.y - p.y;
+  float dist = sqrtf(dx * dx + dy * dy);
+  if (dist > 1.0f) {
+    p.x += dx / dist * speed;
+    p.y += dy / dist * speed;
+  }
+  return p;
+}
+
+static void update_aos(ParticleAoS *ps, size_t n, Vector2 t) {
+  for (size_t i = 0; i < n; i++)
+    ps[i].position = step(ps[i].position, ps[i].speed, t);
+}
+
+static void update_soa(Particle_soa *ps, Vector2 t) {
+  Vector2 *pos = soa_assume_aligned(ps->position);
+  const float *speed = soa_assume_aligned(ps->speed);
+  const size_t n = ps->count; /* hoisted: stores to pos could alias it */
+  for (size_t i = 0; i < n; i++)
+    pos[i] = step(pos[i], speed[i], t);
+}
+
+static void update_split(ParticleSplit_soa *ps, Vector2 t) {
+  float *x = soa_assume_aligned(ps->x);
+  float *y = soa_assume_aligned(ps->y);
+  const float *speed = soa_assume_aligned(ps->speed);
+  const size_t n = ps->count;
+  for (size_t i = 0; i < n; i++) {
+    float dx = t.x - x[i], dy = t.y - y[i];
+    float dist = sqrtf(dx * dx + dy * dy);
+    /* Selects instead of a branch so the loop can be if-converted */
+    float sp = speed[i];
+    float k = (dist > 1.0f ? sp : 0.0f) / (dist > 1.0f ? dist : 1.0f);
+    x[i] += dx * k;
+    y[i] += dy * k;
+  }
+}
+
+static Vector2 target_at(int frame) {
+  return (Vector2){400.0f + 300.0f * cosf((float)frame * 0.05f),
+                   300.0f + 200.0f * sinf((float)frame * 0.07f)};
+}
+
+int main(void) {
+  ParticleAoS *aos = malloc(N * sizeof *aos);
+  Particle_soa soa;
+  ParticleSplit_soa split;
+  Particle_soa_init(&soa);
+  ParticleSplit_soa_init(&split);
+  Particle_soa_reserve(&soa, N);
+
+  unsigned seed = 42;
+  for (size_t i = 0; i < N; i++) {
+    Vector2 p = {rnd(&seed) * 800.0f, rnd(&seed) * 600.0f};
+    Color c = {(unsigned char)i, 100, 200, 255};
+    float sp = 2.0f + 3.0f * rnd(&seed);
+    aos[i] = (ParticleAoS){p, c, sp};
+    Particle_soa_push(&soa, (Particle){p, c, sp});
+    ParticleSplit_soa_push(&split, (ParticleSplit){p.x, p.y, c, sp});
+  }
+  assert((uintptr_t)soa.position % SOA_ALIGN == 0);
+  assert((uintptr_t)soa.speed % SOA_ALIGN == 0);
+
+  double t0 = now_sec();
+  for (int f = 0; f < FRAMES; f++)
+    update_aos(aos, N, target_at(f));
+  double t_aos = now_sec() - t0;
+
+  t0 = now_sec();
+  for (int f = 0; f < FRAMES; f++)
+    update_soa(&soa, target_at(f));
+  double t_soa = now_sec() - t0;
+
+  t0 = now_sec();
+  for (int f = 0; f < FRAMES; f++)
+    update_split(&split, target_at(f));
+  double t_split = now_sec() - t0;
+
+  /* Same simulation, same results (within float reassociation) */
+  for (size_t i = 0; i < N; i += 4099) {
+    Particle p = Particle_soa_get(&soa, i);
+    assert(p.position.x == aos[i].position.x);
+    assert(fabsf(split.x[i] - aos[i].position.x) < 0.5f);
+  }
+
+  double per = 1e9 / ((double)N * FRAMES);
+  printf("%d particles x %d frames\n", N, FRAMES);
+  printf("  aos        %6.2f ns/particle\n", t_aos * per);
+  printf("  soa        %6.2f ns/particle  (%.2fx)\n", t_soa * per,
+         t_aos / t_soa);
+  printf("  soa split  %6.2f ns/particle  (%.2fx)\n", t_split * per,
+         t_aos / t_split);
+
+  free(aos);
+  Particle_soa_free(&soa);
+  ParticleSplit_soa_free(&split);
+  return 0;
+}
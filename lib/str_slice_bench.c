@@ -0,0 +1,158 @@
+/*
+ * str_slice_bench.c — slice tokenizing/parsing vs strtok_r + strtoll
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 str_slice_bench.c -o str_slice_bench
+ *
+ *   csv    — 8 MiB of "int,int,...\n" rows; split lines and fields, parse
+ *            and sum every integer. strtok_r needs a writable copy of the
+ *            input (it plants NULs), which is counted.
+ *   words  — 8 MiB of prose split on whitespace: strtok_r with a delimiter
+ *            set vs str_split_words (SSE2 whitespace scan)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "slices.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BYTES (8 << 20)
+#define REPS 10
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static char *make_csv(size_t *len) {
+  char *buf = malloc(BYTES + 64);
+  size_t n = 0;
+  unsigned s = 7;
+  while (n < BYTES) {
+    for (int col = 0; col < 8; col++) {
+      s = s * 1664525u + 1013904223u;
+      int v = (int)(s >> 12) % 200000 - 100000;
+      n += (size_t)sprintf(buf + n, col ? ",%d" : "%d", v);
+    }
+    buf[n++] = '\n';
+  }
+  buf[n] = '\0';
+  *len = n;
+  return buf;
+}
+
+static char *make_words(size_t *len) {
+  static const char *w[] = {"the", "quick", "brown", "fox",    "jumps",
+                            "over", "a",    "lazy",  "dog\n", "again\t"};
+  char *buf = malloc(BYTES + 64);
+  size_t n = 0;
+  unsigned s = 3;
+  while (n < BYTES) {
+    s = s * 1664525u + 1013904223u;
+    const char *word = w[(s >> 16) % 10];
+    size_t wl = strlen(word);
+    memcpy(buf + n, word, wl);
+    n += wl;
+    buf[n++] = ' ';
+  }
+  buf[n] = '\0';
+  *len = n;
+  return buf;
+}
+
+static long csv_libc(const char *text, size_t len, char *scratch) {
+  memcpy(scratch, text, len + 1);
+  long sum = 0;
+  char *line_save, *field_save;
+  for (char *line = strtok_r(scratch, "\n", &line_save); line;
+       line = strtok_r(NULL, "\n", &line_save))
+    for (char *f = strtok_r(line, ",", &field_save); f;
+         f = strtok_r(NULL, ",", &field_save))
+      sum += strtoll(f, NULL, 10);
+  return sum;
+}
+
+static long csv_slices(const char *text, size_t len) {
+  long sum = 0;
+  str_split_t lines = str_split(str_slice_make(text, len), '\n');
+  str_slice line, field;
+  while (str_split_next(&lines, &line)) {
+    str_split_t fields = str_split(line, ',');
+    while (str_split_next(&fields, &field)) {
+      int64_t v;
+      if (str_slice_parse_i64(field, &v))
+        sum += v;
+    }
+  }
+  return sum;
+}
+
+static size_t words_libc(const char *text, size_t len, char *scratch) {
+  memcpy(scratch, text, len + 1);
+  size_t n = 0, bytes = 0;
+  char *save;
+  for (char *w = strtok_r(scratch, STR_SLICE_WHITESPACE, &save); w;
+       w = strtok_r(NULL, STR_SLICE_WHITESPACE, &save)) {
+    n++;
+    bytes += strlen(w);
+  }
+  return n ^ bytes;
+}
+
+static size_t words_slices(const char *text, size_t len) {
+  size_t n = 0, bytes = 0;
+  str_split_t it = str_split_words(str_slice_make(text, len));
+  str_slice w;
+  while (str_split_next(&it, &w)) {
+    n++;
+    bytes += w.len;
+  }
+  return n ^ bytes;
+}
+
+static void report(const char *name, size_t len, double libc_s,
+                   double slice_s) {
+  double mb = (double)len * REPS / 1e6;
+  printf("  %-6s libc %8.1f MB/s   slices %8.1f MB/s   %5.2fx\n", name,
+         mb / libc_s, mb / slice_s, libc_s / slice_s);
+}
+
+int main(void) {
+  size_t csv_len, words_len;
+  char *csv = make_csv(&csv_len);
+  char *words = make_words(&words_len);
+  char *scratch = malloc(BYTES + 64);
+
+  long a = 0, b = 0;
+  double t0 = now_sec();
+  for (int r = 0; r < REPS; r++)
+    a += csv_libc(csv, csv_len, scratch);
+  double t_libc = now_sec() - t0;
+  t0 = now_sec();
+  for (int r = 0; r < REPS; r++)
+    b += csv_slices(csv, csv_len);
+  double t_slices = now_sec() - t0;
+  assert(a == b);
+  report("csv", csv_len, t_libc, t_slices);
+
+  size_t x = 0, y = 0;
+  t0 = now_sec();
+  for (int r = 0; r < REPS; r++)
+    x += words_libc(words, words_len, scratch);
+  t_libc = now_sec() - t0;
+  t0 = now_sec();
+  for (int r = 0; r < REPS; r++)
+    y += words_slices(words, words_len);
+  t_slices = now_sec() - t0;
+  assert(x == y);
+  report("words", words_len, t_libc, t_slices);
+
+  free(csv);
+  free(words);
+  free(scratch);
+  return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * str_slice_demo.c — demo for the string slice toolkit in slices.h
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 str_slice_demo.c -o str_slice_demo
+ */
+
+#include "slices.h"
+#include <assert.h>
+#include <stdio.h>
+
+int main(void) {
+  /* Config lines: key = value, parsed in place */
+  const char *config = "# window\n"
+                       "width = 800\n"
+                       "  speed=2.5  \r\n"
+                       "title = Snake\n"
+                       "\n";
+  str_split_t lines = str_split(str_slice_of(config), '\n');
+  str_slice line, key, val;
+  while (str_split_next(&lines, &line)) {
+    line = str_slice_trim(line);
+    if (line.len == 0 || line.ptr[0] == '#')
+      continue;
+    if (!str_slice_split_once(line, '=', &key, &val))
+      continue;
+    key = str_slice_trim(key);
+    val = str_slice_trim(val);
+    int64_t n;
+    double d;
+    if (str_slice_parse_i64(val, &n))
+      printf("%.*s: int %lld\n", (int)key.len, key.ptr, (long long)n);
+    else if (str_slice_parse_f64(val, &d))
+      printf("%.*s: float %g\n", (int)key.len, key.ptr, d);
+    else
+      printf("%.*s: \"%.*s\"\n", (int)key.len, key.ptr, (int)val.len,
+             val.ptr);
+  }
+  // Expected: width: int 800
+  // Expected: speed: float 2.5
+  // Expected: title: "Snake"
+
+  /* CSV fields keep empty columns */
+  str_split_t csv = str_split(str_slice_of("id,,name,"), ',');
+  str_slice tok;
+  printf("csv:");
+  while (str_split_next(&csv, &tok))
+    printf(" [%.*s]", (int)tok.len, tok.ptr);
+  printf("\n");
+  // Expected: csv: [id] [] [name] []
+
+  /* Command line words: runs of whitespace collapse */
+  str_split_t words = str_split_words(str_slice_of("  move\t 10   -3 \n"));
+  printf("argv:");
+  while (str_split_next(&words, &tok))
+    printf(" [%.*s]", (int)tok.len, tok.ptr);
+  printf("\n");
+  // Expected: argv: [move] [10] [-3]
+
+  /* Searching */
+  str_slice text = str_slice_of("the quick brown fox, the lazy dog");
+  assert(str_slice_find(text, str_slice_of("the lazy")) == 21);
+  assert(str_slice_find(text, str_slice_of("cat")) == text.len);
+  assert(str_slice_find_any(text, ",;") == 19);
+  assert(str_slice_rfind_byte(text, 'o') == 31);
+  assert(str_slice_starts_with(text, str_slice_of("the ")));
+  assert(str_slice_ends_with(text, str_slice_of("dog")));
+
+  /* Numbers: the whole slice must parse, overflow is rejected */
+  int64_t i;
+  uint64_t u;
+  assert(str_slice_parse_i64(str_slice_of("-9223372036854775808"), &i) &&
+         i == INT64_MIN);
+  assert(!str_slice_parse_i64(str_slice_of("9223372036854775808"), &i));
+  assert(str_slice_parse_u64(str_slice_of("18446744073709551615"), &u) &&
+         u == UINT64_MAX);
+  assert(!str_slice_parse_u64(str_slice_of("18446744073709551616"), &u));
+  assert(!str_slice_parse_i64(str_slice_of("12px"), &i));
+  assert(!str_slice_parse_i64(str_slice_of(""), &i));
+  assert(!str_slice_parse_i64(str_slice_of("-"), &i));
+
+  /* A view into the middle of a buffer, no copy or terminator */
+  str_slice mid = str_slice_make(text.ptr + 4, 5);
+  assert(str_slice_eq_cstr(mid, "quick"));
+
+  printf("ok\n");
+  // Expected: ok
+  return 0;
+}
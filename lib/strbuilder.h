@@ -1,136 +1,444 @@
 #ifndef STRBUILDER_H
 #define STRBUILDER_H
 
+#include "numfmt.h"
+
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#define STRBUILDER_HAVE_WRITEV 1
+#include <errno.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
 /*
    ╔══════════════════════════════════════════════════════════╗
    ║              Ultimate StrBuilder v1.0 (2025)             ║
    ║  Zero-allocation failures · Blazing fast · No surprises ║
    ╚══════════════════════════════════════════════════════════╝
+
+   The one string builder for lib/ (str_builder.h is a thin alias layer).
+   Short strings live in a STRBUILDER_INLINE (64) byte buffer inside the
+   struct and never touch the heap; longer ones move to a heap buffer that
+   doubles. Zero-init ({0}) is an empty builder.
+
+     strbuilder_t sb = {0};
+     strbuilder_appendf(&sb, "%s=%d", key, v);
+     puts(strbuilder_view(&sb));      // always NUL-terminated
+     char *s = strbuilder_build(&sb); // move out: caller frees, sb empty
+
+   The struct has no self-pointer, so it may be copied / returned by value,
+   but only one copy may be used afterwards (they would share the heap
+   buffer).
 */
 
+/* Optional: custom allocators (see memtrack.h) */
+#ifndef STRBUILDER_MALLOC
+#define STRBUILDER_MALLOC malloc
+#endif
+
+#ifndef STRBUILDER_REALLOC
+#define STRBUILDER_REALLOC realloc
+#endif
+
+#ifndef STRBUILDER_FREE
+#define STRBUILDER_FREE free
+#endif
+
+#ifndef STRBUILDER_INLINE
+#define STRBUILDER_INLINE 64 /* inline buffer, including the terminator */
+#endif
+
 typedef struct {
-  char *data;      // null-terminated string
-  size_t capacity; // total allocated (including null terminator)
+  char *heap;      // heap buffer, or NULL while the text fits in `small`
+  size_t capacity; // heap bytes (including null terminator)
   size_t len;      // length without null terminator
+  char small[STRBUILDER_INLINE];
 } strbuilder_t;
 
-/* Create new builder */
-static inline strbuilder_t strbuilder_new(const char *initial) {
-  strbuilder_t sb = {0};
-  if (!initial || !*initial)
-    return sb;
-
-  sb.len = strlen(initial);
-  sb.capacity = sb.len + 1;
-  sb.data = (char *)malloc(sb.capacity);
-  if (sb.data)
-    memcpy(sb.data, initial, sb.capacity);
-  return sb;
+/* Current buffer and its size (including the null terminator) */
+static inline char *strbuilder__buf(strbuilder_t *sb) {
+  return sb->heap ? sb->heap : sb->small;
 }
 
-/* Free the builder */
-static inline void strbuilder_free(strbuilder_t *sb) {
-  if (!sb)
-    return;
-  free(sb->data);
-  sb->data = NULL;
-  sb->capacity = sb->len = 0;
+static inline size_t strbuilder__cap(const strbuilder_t *sb) {
+  return sb->heap ? sb->capacity : STRBUILDER_INLINE;
 }
 
 /* Ensure there's room for at least `need` more bytes + null terminator */
 static inline int strbuilder_ensure(strbuilder_t *sb, size_t need) {
-  size_t required = sb->len + need + 1;
-  if (required <= sb->capacity)
+  size_t cap = strbuilder__cap(sb);
+  if (need < cap - sb->len)
     return 1;
+  if (need > (size_t)-1 / 2 - sb->len)
+    return 0;
 
-  size_t new_cap = sb->capacity ? sb->capacity * 2 : 64;
+  size_t required = sb->len + need + 1;
+  size_t new_cap = cap * 2;
   while (new_cap < required)
     new_cap *= 2;
 
-  char *new_data = (char *)realloc(sb->data, new_cap);
-  if (!new_data)
+  char *p;
+  if (sb->heap) {
+    p = (char *)STRBUILDER_REALLOC(sb->heap, new_cap);
+  } else { /* spill out of the inline buffer */
+    p = (char *)STRBUILDER_MALLOC(new_cap);
+    if (p)
+      memcpy(p, sb->small, sb->len + 1);
+  }
+  if (!p)
     return 0;
 
-  sb->data = new_data;
+  sb->heap = p;
   sb->capacity = new_cap;
   return 1;
 }
 
-/* Append raw C string */
-static inline int strbuilder_append(strbuilder_t *sb, const char *str) {
-  if (!str)
-    return 1;
-  size_t add = strlen(str);
-  if (!strbuilder_ensure(sb, add))
+/* Append n bytes (need not be NUL-terminated, e.g. a str_slice) */
+static inline int strbuilder_append_n(strbuilder_t *sb, const char *str,
+                                      size_t n) {
+  if (!strbuilder_ensure(sb, n))
     return 0;
-  memcpy(sb->data + sb->len, str, add);
-  sb->len += add;
-  sb->data[sb->len] = '\0';
+  char *buf = strbuilder__buf(sb);
+  memcpy(buf + sb->len, str, n);
+  sb->len += n;
+  buf[sb->len] = '\0';
   return 1;
 }
 
+/* Create new builder */
+static inline strbuilder_t strbuilder_new(const char *initial) {
+  strbuilder_t sb = {0};
+  if (initial)
+    strbuilder_append_n(&sb, initial, strlen(initial));
+  return sb;
+}
+
+/* Free the builder (it is empty and reusable afterwards) */
+static inline void strbuilder_free(strbuilder_t *sb) {
+  if (!sb)
+    return;
+  STRBUILDER_FREE(sb->heap);
+  sb->heap = NULL;
+  sb->capacity = sb->len = 0;
+  sb->small[0] = '\0';
+}
+
+/* Append raw C string */
+static inline int strbuilder_append(strbuilder_t *sb, const char *str) {
+  return str ? strbuilder_append_n(sb, str, strlen(str)) : 1;
+}
+
 /* Append single char */
 static inline int strbuilder_append_char(strbuilder_t *sb, char c) {
   if (!strbuilder_ensure(sb, 1))
     return 0;
-  sb->data[sb->len++] = c;
-  sb->data[sb->len] = '\0';
+  char *buf = strbuilder__buf(sb);
+  buf[sb->len++] = c;
+  buf[sb->len] = '\0';
+  return 1;
+}
+
+/* printf-style append. Formats straight into the spare capacity and only
+ * grows + formats again if the output did not fit, so the common case is
+ * one vsnprintf pass instead of measure-then-write. */
+static inline int strbuilder_vappendf(strbuilder_t *sb, const char *fmt,
+                                      va_list args) {
+  va_list retry;
+  va_copy(retry, args);
+  size_t room = strbuilder__cap(sb) - sb->len; // includes the terminator
+  int needed = vsnprintf(strbuilder__buf(sb) + sb->len, room, fmt, args);
+  if (needed >= 0 && (size_t)needed >= room) {
+    if (strbuilder_ensure(sb, (size_t)needed))
+      vsnprintf(strbuilder__buf(sb) + sb->len, (size_t)needed + 1, fmt,
+                retry);
+    else
+      needed = -1;
+  }
+  va_end(retry);
+  if (needed < 0) {
+    strbuilder__buf(sb)[sb->len] = '\0'; // drop any truncated output
+    return 0;
+  }
+  sb->len += (size_t)needed;
   return 1;
 }
 
-/* printf-style append */
 static inline int strbuilder_appendf(strbuilder_t *sb, const char *fmt, ...) {
-  va_list args, args_copy;
+  va_list args;
   va_start(args, fmt);
-  va_copy(args_copy, args);
+  int ok = strbuilder_vappendf(sb, fmt, args);
+  va_end(args);
+  return ok;
+}
 
-  int needed = vsnprintf(NULL, 0, fmt, args_copy);
-  va_end(args_copy);
-  if (needed < 0) {
-    va_end(args);
+/* Numbers without printf (see numfmt.h); f64 writes the shortest digits
+ * that read back as the same double: 0.1 -> "0.1", 1e21 -> "1e+21" */
+static inline int strbuilder_append_u64(strbuilder_t *sb, uint64_t v) {
+  if (!strbuilder_ensure(sb, NUMFMT_MAX))
     return 0;
-  }
+  char *buf = strbuilder__buf(sb);
+  sb->len += numfmt_u64(buf + sb->len, v);
+  buf[sb->len] = '\0';
+  return 1;
+}
 
-  if (!strbuilder_ensure(sb, needed)) {
-    va_end(args);
+static inline int strbuilder_append_i64(strbuilder_t *sb, int64_t v) {
+  if (!strbuilder_ensure(sb, NUMFMT_MAX))
     return 0;
-  }
+  char *buf = strbuilder__buf(sb);
+  sb->len += numfmt_i64(buf + sb->len, v);
+  buf[sb->len] = '\0';
+  return 1;
+}
 
-  vsnprintf(sb->data + sb->len, needed + 1, fmt, args);
-  sb->len += needed;
-  va_end(args);
+static inline int strbuilder_append_f64(strbuilder_t *sb, double v) {
+  if (!strbuilder_ensure(sb, NUMFMT_MAX))
+    return 0;
+  char *buf = strbuilder__buf(sb);
+  sb->len += numfmt_f64(buf + sb->len, v);
+  buf[sb->len] = '\0';
   return 1;
 }
 
-/* Get final string — ownership transferred! (set sb->data = NULL after use) */
-static inline char *strbuilder_build(strbuilder_t *sb) {
-  if (!sb || !sb->data)
-    return strdup("");
-  /* Optional: shrink to fit */
-  if (sb->len + 1 < sb->capacity) {
-    sb->data = (char *)realloc(sb->data, sb->len + 1);
-    sb->capacity = sb->len + 1;
+/* Move the string out: the caller owns (and frees) the result and the
+ * builder is left empty. A heap buffer is handed over as is, with no
+ * shrink-to-fit realloc; inline text is copied to an exact-size block.
+ * *len (optional) receives the length. NULL only if that copy fails. */
+static inline char *strbuilder_take(strbuilder_t *sb, size_t *len) {
+  char *out = sb->heap;
+  if (!out) {
+    out = (char *)STRBUILDER_MALLOC(sb->len + 1);
+    if (!out)
+      return NULL;
+    memcpy(out, sb->small, sb->len + 1);
   }
-  return sb->data;
+  if (len)
+    *len = sb->len;
+  sb->heap = NULL;
+  sb->capacity = sb->len = 0;
+  sb->small[0] = '\0';
+  return out;
+}
+
+/* Get final string — ownership transferred, builder left empty */
+static inline char *strbuilder_build(strbuilder_t *sb) {
+  return strbuilder_take(sb, NULL);
 }
 
-/* Get const view — do NOT free */
+/* Get const view — do NOT free; valid until the next append */
 static inline const char *strbuilder_view(const strbuilder_t *sb) {
-  return sb && sb->data ? sb->data : "";
+  if (!sb)
+    return "";
+  return sb->heap ? sb->heap : sb->small;
+}
+
+static inline size_t strbuilder_len(const strbuilder_t *sb) {
+  return sb->len;
 }
 
 /* Clear but keep allocation */
 static inline void strbuilder_clear(strbuilder_t *sb) {
   if (sb) {
     sb->len = 0;
-    if (sb->data)
-      sb->data[0] = '\0';
+    strbuilder__buf(sb)[0] = '\0';
   }
 }
 
+/*
+ * Chunked mode (strrope_t) — for outputs too big to double-and-copy
+ *
+ * strbuilder_t keeps one contiguous buffer, so a multi-hundred-MB report
+ * pays for every doubling realloc and peaks at ~2x its size. strrope_t
+ * appends into a list of fixed STRROPE_CHUNK blocks instead: nothing is
+ * ever copied twice, peak memory is the text plus one partly-filled chunk,
+ * and strrope_flush() hands the blocks straight to writev(). A contiguous
+ * string is only made if you ask for one (strrope_build).
+ *
+ *   strrope_t r = {0};
+ *   for (...)
+ *     strrope_appendf(&r, "%d,%s\n", id, name);
+ *   strrope_flush(&r, STDOUT_FILENO); // writes and empties
+ *   strrope_free(&r);
+ */
+
+#ifndef STRROPE_CHUNK
+#define STRROPE_CHUNK (64 * 1024)
+#endif
+
+typedef struct strrope_chunk {
+  struct strrope_chunk *next;
+  size_t len; // bytes used
+  size_t cap; // usually STRROPE_CHUNK; larger for one oversized appendf
+  char data[];
+} strrope_chunk_t;
+
+typedef struct {
+  strrope_chunk_t *head;
+  strrope_chunk_t *tail; // chunk being appended to
+  size_t len;            // total bytes across chunks
+} strrope_t;
+
+static inline size_t strrope_len(const strrope_t *r) { return r->len; }
+
+/* Start a new tail chunk with room for at least `need` bytes */
+static inline strrope_chunk_t *strrope__grow(strrope_t *r, size_t need) {
+  size_t cap = need > STRROPE_CHUNK ? need : STRROPE_CHUNK;
+  strrope_chunk_t *c =
+      (strrope_chunk_t *)STRBUILDER_MALLOC(sizeof(strrope_chunk_t) + cap);
+  if (!c)
+    return NULL;
+  c->next = NULL;
+  c->len = 0;
+  c->cap = cap;
+  if (r->tail)
+    r->tail->next = c;
+  else
+    r->head = c;
+  r->tail = c;
+  return c;
+}
+
+/* Append n bytes: fill the tail chunk, then put the rest in a new one */
+static inline int strrope_append_n(strrope_t *r, const char *str, size_t n) {
+  strrope_chunk_t *c = r->tail;
+  size_t room = c ? c->cap - c->len : 0;
+  size_t first = n < room ? n : room;
+  if (first) {
+    memcpy(c->data + c->len, str, first);
+    c->len += first;
+  }
+  if (n > first) {
+    if (!(c = strrope__grow(r, n - first))) {
+      r->len += first;
+      return 0;
+    }
+    memcpy(c->data, str + first, n - first);
+    c->len = n - first;
+  }
+  r->len += n;
+  return 1;
+}
+
+static inline int strrope_append(strrope_t *r, const char *str) {
+  return str ? strrope_append_n(r, str, strlen(str)) : 1;
+}
+
+static inline int strrope_append_char(strrope_t *r, char c) {
+  strrope_chunk_t *t = r->tail;
+  if (!t || t->len == t->cap)
+    if (!(t = strrope__grow(r, 1)))
+      return 0;
+  t->data[t->len++] = c;
+  r->len++;
+  return 1;
+}
+
+/* printf-style append. Formats straight into the tail chunk; output that
+ * does not fit moves whole to a fresh chunk (sized for it if needed), so
+ * a formatted piece is never split and never goes through a temp buffer. */
+static inline int strrope_appendf(strrope_t *r, const char *fmt, ...) {
+  va_list args, retry;
+  va_start(args, fmt);
+  va_copy(retry, args);
+
+  strrope_chunk_t *c = r->tail;
+  size_t room = c ? c->cap - c->len : 0;
+  int n = vsnprintf(c ? c->data + c->len : NULL, room, fmt, args);
+  va_end(args);
+  if (n >= 0 && (size_t)n >= room) {
+    /* +1: vsnprintf always writes a terminator */
+    if ((c = strrope__grow(r, (size_t)n + 1)))
+      vsnprintf(c->data, c->cap, fmt, retry);
+  }
+  va_end(retry);
+  if (n < 0 || !c)
+    return 0;
+  c->len += (size_t)n;
+  r->len += (size_t)n;
+  return 1;
+}
+
+/* Copy everything into one malloc'd, NUL-terminated string (caller frees).
+ * The rope is left as is. */
+static inline char *strrope_build(const strrope_t *r) {
+  char *out = (char *)STRBUILDER_MALLOC(r->len + 1);
+  if (!out)
+    return NULL;
+  size_t off = 0;
+  for (const strrope_chunk_t *c = r->head; c; c = c->next) {
+    memcpy(out + off, c->data, c->len);
+    off += c->len;
+  }
+  out[off] = '\0';
+  return out;
+}
+
+/* Drop the text but keep the first chunk for reuse */
+static inline void strrope_clear(strrope_t *r) {
+  if (!r->head)
+    return;
+  strrope_chunk_t *c = r->head->next;
+  while (c) {
+    strrope_chunk_t *next = c->next;
+    STRBUILDER_FREE(c);
+    c = next;
+  }
+  r->head->next = NULL;
+  r->head->len = 0;
+  r->tail = r->head;
+  r->len = 0;
+}
+
+static inline void strrope_free(strrope_t *r) {
+  strrope_chunk_t *c = r->head;
+  while (c) {
+    strrope_chunk_t *next = c->next;
+    STRBUILDER_FREE(c);
+    c = next;
+  }
+  r->head = r->tail = NULL;
+  r->len = 0;
+}
+
+#ifdef STRBUILDER_HAVE_WRITEV
+/* Write the whole rope to fd with writev (up to 64 chunks per call, partial
+ * writes and EINTR handled), then clear it. Returns 1, or 0 on a write
+ * error with errno set; the rope is left intact on error. */
+static inline int strrope_flush(strrope_t *r, int fd) {
+  enum { BATCH = 64 };
+  struct iovec iov[BATCH];
+  const strrope_chunk_t *c = r->head;
+  size_t skip = 0; // bytes of c already written
+  while (c) {
+    int n = 0;
+    for (const strrope_chunk_t *k = c; k && n < BATCH; k = k->next, n++) {
+      iov[n].iov_base = (void *)(k->data + (k == c ? skip : 0));
+      iov[n].iov_len = k->len - (k == c ? skip : 0);
+    }
+    ssize_t w = writev(fd, iov, n);
+    if (w < 0) {
+      if (errno == EINTR)
+        continue;
+      return 0;
+    }
+    /* Advance past what was written */
+    size_t left = (size_t)w;
+    while (c && left >= c->len - skip) {
+      left -= c->len - skip;
+      skip = 0;
+      c = c->next;
+    }
+    skip += left;
+  }
+  strrope_clear(r);
+  return 1;
+}
+#endif
+
 #endif /* STRBUILDER_H */
@@ -1,4 +1,5 @@
 #include "strbuilder.h"
+#include <assert.h>
 #include <stdio.h>
 
 int main() {
@@ -18,7 +19,52 @@ int main() {
   printf("Owned string: %s\n", final);
 
   free(final); // because we called strbuilder_build
-  // sb.data is now garbage — don't use sb after build() unless you reset
+  // build() moved the text out: sb is empty again and can be reused
+  assert(strbuilder_len(&sb) == 0 && *strbuilder_view(&sb) == '\0');
+
+  // Short strings stay in the 64-byte inline buffer: no heap at all
+  strbuilder_t tag = {0};
+  strbuilder_append(&tag, "player");
+  strbuilder_append_n(&tag, "42-extra", 2); // slice, not NUL-terminated
+  assert(tag.heap == NULL);
+  printf("Tag: %s\n", strbuilder_view(&tag));
+  // Expected: Tag: player42
+  strbuilder_free(&tag);
+
+  // Numbers without printf: shortest text that reads back exactly
+  strbuilder_t nums = {0};
+  strbuilder_append_u64(&nums, 18446744073709551615u);
+  strbuilder_append_char(&nums, ' ');
+  strbuilder_append_i64(&nums, -42);
+  strbuilder_append_char(&nums, ' ');
+  strbuilder_append_f64(&nums, 0.1 + 0.2);
+  strbuilder_append_char(&nums, ' ');
+  strbuilder_append_f64(&nums, 1.5e-7);
+  printf("Numbers: %s\n", strbuilder_view(&nums));
+  // Expected: Numbers: 18446744073709551615 -42 0.30000000000000004 1.5e-7
+  strbuilder_free(&nums);
+
+  // Chunked mode: a large report built in 64 KiB blocks, no reallocs
+  strrope_t report = {0};
+  strrope_append(&report, "id,name,score\n");
+  for (int i = 0; i < 20000; i++)
+    strrope_appendf(&report, "%d,player%d,%.1f\n", i, i, i * 0.5);
+  printf("Report: %zu bytes\n", strrope_len(&report));
+  // Expected: Report: 475574 bytes
+
+  char *flat = strrope_build(&report); // contiguous copy, on demand only
+  assert(strlen(flat) == strrope_len(&report));
+  assert(strcmp(flat + strlen(flat) - 25, "19999,player19999,9999.5\n") == 0);
+  free(flat);
+
+#ifdef STRBUILDER_HAVE_WRITEV
+  strrope_clear(&report); // keeps one chunk for reuse
+  strrope_append(&report, "flushed with writev\n");
+  fflush(stdout);             // the rope bypasses stdio
+  strrope_flush(&report, 1); // Expected: flushed with writev
+  assert(strrope_len(&report) == 0);
+#endif
+  strrope_free(&report);
 
   return 0;
 }
@@ -1,11 +1,12 @@
 #define TUI_IMPLEMENTATION
+#include "ringbuf.h"
 #include "tui.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
 
-#define MAX_CPU_SAMPLES 50
+#define MAX_CPU_SAMPLES 64
 #define UPDATE_INTERVAL 1000 // milliseconds
 #define MAX_PROCESSES 20
 
@@ -32,9 +33,8 @@ typedef struct {
   unsigned long mem_kb;
 } Process;
 
-// CPU history for graph
-float cpu_history[MAX_CPU_SAMPLES];
-int history_index = 0;
+// CPU history for graph (keeps the newest MAX_CPU_SAMPLES readings)
+rb_t(float) cpu_history = NULL;
 
 void read_cpu_stats(CPUStats *stats) {
   FILE *fp = fopen("/proc/stat", "r");
@@ -158,10 +158,13 @@ void draw_cpu_graph(int y, int x, int width, int height) {
   int graph_width = width - 4;
   int graph_height = height - 3;
 
-  for (int i = 0; i < graph_width && i < MAX_CPU_SAMPLES; i++) {
-    int idx =
-        (history_index - graph_width + i + MAX_CPU_SAMPLES) % MAX_CPU_SAMPLES;
-    float val = cpu_history[idx];
+  size_t samples = rb_count(cpu_history);
+  size_t shown = graph_width <= 0                    ? 0
+                 : (size_t)graph_width < samples ? (size_t)graph_width
+                                                 : samples;
+
+  for (size_t i = 0; i < shown; i++) {
+    float val = rb_at(cpu_history, samples - shown + i);
 
     int bar_height = (int)(val * graph_height / 100.0f);
 
@@ -288,8 +291,10 @@ int main() {
   MemStats mem_stats;
   Process processes[MAX_PROCESSES];
 
-  // Initialize CPU history
-  memset(cpu_history, 0, sizeof(cpu_history));
+  // Initialize CPU history with zeros so the graph starts full width
+  float zeros[MAX_CPU_SAMPLES] = {0};
+  rb_init(cpu_history, MAX_CPU_SAMPLES, RB_OVERWRITE);
+  rb_put_n(cpu_history, zeros, MAX_CPU_SAMPLES);
 
   // Initial CPU reading
   read_cpu_stats(&prev_stats);
@@ -305,8 +310,7 @@ int main() {
     float cpu_percent = calculate_cpu_usage(&prev_stats, &curr_stats);
 
     // Update CPU history
-    cpu_history[history_index] = cpu_percent;
-    history_index = (history_index + 1) % MAX_CPU_SAMPLES;
+    rb_put(cpu_history, cpu_percent);
 
     // Get top processes
     int proc_count = get_top_processes(processes, MAX_PROCESSES);
@@ -325,6 +329,7 @@ int main() {
   }
 
   tui_end();
+  rb_free(cpu_history);
   printf("System monitor terminated.\n");
 
   return 0;
@@ -0,0 +1,135 @@
+#ifndef CALCULATOR_LOGIC_H
+#define CALCULATOR_LOGIC_H
+
+// Calculator state and actions, free of rendering: shared by
+// calculator_reactive.c and headless_bench.c
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Calculator Domain ---
+
+#define MAX_INPUT_CHARS 20
+
+typedef enum { OP_NONE, OP_ADD, OP_SUB, OP_MUL, OP_DIV } Operation;
+
+typedef struct {
+  char displayBuffer[MAX_INPUT_CHARS + 1];
+  float result;
+  float currentVal;
+  Operation currentOp;
+  bool newNumber;
+} CalcState;
+
+// --- Actions ---
+
+static inline void Action_Clear(CalcState *s) {
+  strcpy(s->displayBuffer, "0");
+  s->result = 0.0f;
+  s->currentOp = OP_NONE;
+  s->newNumber = true;
+}
+
+static inline void Action_Digit(CalcState *s, char digit) {
+  if (s->newNumber) {
+    strcpy(s->displayBuffer, "");
+    s->newNumber = false;
+  }
+  if (strlen(s->displayBuffer) < MAX_INPUT_CHARS) {
+    int len = strlen(s->displayBuffer);
+    s->displayBuffer[len] = digit;
+    s->displayBuffer[len + 1] = '\0';
+  }
+}
+
+static inline void Action_Decimal(CalcState *s) {
+  if (s->newNumber) {
+    strcpy(s->displayBuffer, "0.");
+    s->newNumber = false;
+  } else if (strchr(s->displayBuffer, '.') == NULL) {
+    strcat(s->displayBuffer, ".");
+  }
+}
+
+static inline void Calculate(CalcState *s) {
+  s->currentVal = (float)atof(s->displayBuffer);
+  switch (s->currentOp) {
+  case OP_ADD:
+    s->result += s->currentVal;
+    break;
+  case OP_SUB:
+    s->result -= s->currentVal;
+    break;
+  case OP_MUL:
+    s->result *= s->currentVal;
+    break;
+  case OP_DIV:
+    if (s->currentVal != 0)
+      s->result /= s->currentVal;
+    break;
+  default:
+    break;
+  }
+}
+
+static inline void UpdateDisplayFromResult(CalcState *s) {
+  if (s->result == (int)s->result)
+    snprintf(s->displayBuffer, MAX_INPUT_CHARS, "%d", (int)s->result);
+  else
+    snprintf(s->displayBuffer, MAX_INPUT_CHARS, "%.2f", s->result);
+}
+
+static inline void Action_Operator(CalcState *s, Operation op) {
+  if (!s->newNumber && s->currentOp != OP_NONE) {
+    Calculate(s);
+    UpdateDisplayFromResult(s);
+  } else {
+    s->result = (float)atof(s->displayBuffer);
+  }
+  s->currentOp = op;
+  s->newNumber = true;
+}
+
+static inline void Action_Equals(CalcState *s) {
+  if (s->currentOp != OP_NONE) {
+    Calculate(s);
+    UpdateDisplayFromResult(s);
+    s->currentOp = OP_NONE;
+    s->newNumber = true;
+  }
+}
+
+// One button press by its label ('0'-'9', '.', 'C', '=', '+', '-', '*',
+// '/'); false if the label is not a button
+static inline bool Action_Press(CalcState *s, char label) {
+  if (label >= '0' && label <= '9') {
+    Action_Digit(s, label);
+  } else if (label == '.') {
+    Action_Decimal(s);
+  } else if (label == 'C') {
+    Action_Clear(s);
+  } else if (label == '=') {
+    Action_Equals(s);
+  } else if (label == '+') {
+    Action_Operator(s, OP_ADD);
+  } else if (label == '-') {
+    Action_Operator(s, OP_SUB);
+  } else if (label == '*') {
+    Action_Operator(s, OP_MUL);
+  } else if (label == '/') {
+    Action_Operator(s, OP_DIV);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static inline void InitCalcState(CalcState *s) {
+  memset(s, 0, sizeof(*s));
+  strcpy(s->displayBuffer, "0");
+  s->newNumber = true;
+}
+
+#endif // CALCULATOR_LOGIC_H
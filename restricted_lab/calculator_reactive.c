@@ -4,100 +4,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "calculator_logic.h"
 #include "lib/reactive.h"
 
-// --- Calculator Domain ---
-
-#define MAX_INPUT_CHARS 20
-
-typedef enum { OP_NONE, OP_ADD, OP_SUB, OP_MUL, OP_DIV } Operation;
-
-typedef struct {
-  char displayBuffer[MAX_INPUT_CHARS + 1];
-  float result;
-  float currentVal;
-  Operation currentOp;
-  bool newNumber;
-} CalcState;
-
-// --- Actions ---
-
-void Action_Clear(CalcState *s) {
-  strcpy(s->displayBuffer, "0");
-  s->result = 0.0f;
-  s->currentOp = OP_NONE;
-  s->newNumber = true;
-}
-
-void Action_Digit(CalcState *s, char digit) {
-  if (s->newNumber) {
-    strcpy(s->displayBuffer, "");
-    s->newNumber = false;
-  }
-  if (strlen(s->displayBuffer) < MAX_INPUT_CHARS) {
-    int len = strlen(s->displayBuffer);
-    s->displayBuffer[len] = digit;
-    s->displayBuffer[len + 1] = '\0';
-  }
-}
-
-void Action_Decimal(CalcState *s) {
-  if (s->newNumber) {
-    strcpy(s->displayBuffer, "0.");
-    s->newNumber = false;
-  } else if (strchr(s->displayBuffer, '.') == NULL) {
-    strcat(s->displayBuffer, ".");
-  }
-}
-
-void Calculate(CalcState *s) {
-  s->currentVal = (float)atof(s->displayBuffer);
-  switch (s->currentOp) {
-  case OP_ADD:
-    s->result += s->currentVal;
-    break;
-  case OP_SUB:
-    s->result -= s->currentVal;
-    break;
-  case OP_MUL:
-    s->result *= s->currentVal;
-    break;
-  case OP_DIV:
-    if (s->currentVal != 0)
-      s->result /= s->currentVal;
-    break;
-  default:
-    break;
-  }
-}
-
-void UpdateDisplayFromResult(CalcState *s) {
-  if (s->result == (int)s->result)
-    snprintf(s->displayBuffer, MAX_INPUT_CHARS, "%d", (int)s->result);
-  else
-    snprintf(s->displayBuffer, MAX_INPUT_CHARS, "%.2f", s->result);
-}
-
-void Action_Operator(CalcState *s, Operation op) {
-  if (!s->newNumber && s->currentOp != OP_NONE) {
-    Calculate(s);
-    UpdateDisplayFromResult(s);
-  } else {
-    s->result = (float)atof(s->displayBuffer);
-  }
-  s->currentOp = op;
-  s->newNumber = true;
-}
-
-void Action_Equals(CalcState *s) {
-  if (s->currentOp != OP_NONE) {
-    Calculate(s);
-    UpdateDisplayFromResult(s);
-    s->currentOp = OP_NONE;
-    s->newNumber = true;
-  }
-}
-
 // --- UI / View ---
 
 // Global layout constants
@@ -168,36 +77,7 @@ void HandleInput(ReactiveState *rState) {
           return;
 
         CalcState *s = (CalcState *)rState->data;
-        bool stateChanged = false;
-
-        if (label[0] >= '0' && label[0] <= '9') {
-          Action_Digit(s, label[0]);
-          stateChanged = true;
-        } else if (label[0] == '.') {
-          Action_Decimal(s);
-          stateChanged = true;
-        } else if (label[0] == 'C') {
-          Action_Clear(s);
-          stateChanged = true;
-        } else if (label[0] == '=') {
-          Action_Equals(s);
-          stateChanged = true;
-        } else {
-          Operation op = OP_NONE;
-          if (label[0] == '+')
-            op = OP_ADD;
-          else if (label[0] == '-')
-            op = OP_SUB;
-          else if (label[0] == '*')
-            op = OP_MUL;
-          else if (label[0] == '/')
-            op = OP_DIV;
-
-          if (op != OP_NONE) {
-            Action_Operator(s, op);
-            stateChanged = true;
-          }
-        }
+        bool stateChanged = Action_Press(s, label[0]);
 
         if (stateChanged) {
           SetState(rState);
@@ -212,9 +92,8 @@ int main(void) {
   SetTargetFPS(60);
 
   // Initialize State
-  CalcState calcState = {0};
-  strcpy(calcState.displayBuffer, "0");
-  calcState.newNumber = true;
+  CalcState calcState;
+  InitCalcState(&calcState);
 
   ReactiveState appState;
   InitReactiveState(&appState, &calcState);
@@ -0,0 +1,255 @@
+/*
+ * headless_bench.c — the restricted_lab demos without a window: per-frame
+ * update time, reactive vs plain loop
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 -DHEADLESS headless_bench.c -o headless_bench -lm
+ *
+ * Run:
+ *   ./headless_bench [frames] [particles]     (default 20000 10000)
+ *
+ * Each scenario drives the demo's own update code (particles_logic.h,
+ * snake_logic.h, calculator_logic.h) with scripted input, no raylib:
+ *   particles   — target circles the screen; a burst of 100 spawns every
+ *                 120 frames and the oldest 100 despawn every 180
+ *   snake       — an autopilot steers at the food, one tick per frame,
+ *                 restarting on game over
+ *   calculator  — one button press per frame from a fixed key script
+ * and runs it twice: "reactive" goes through ReactiveState as the demo
+ * does (SetState -> observers; the snake and calculator views are
+ * headless stand-ins for DrawGame / DrawCalculator that lay out the same
+ * cells and text without drawing), "plain" calls the same code directly
+ * in a loop. Both must end in the same state. Every frame is timed and
+ * the report gives percentiles in microseconds.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "calculator_logic.h"
+#include "particles_logic.h"
+#include "snake_logic.h"
+#include <assert.h>
+#include <time.h>
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int particleCount = 10000;
+
+// --- Particles ---
+
+static TargetState pTarget;
+static ReactiveState pState;
+static ReactiveScheduler pScheduler;
+static bool pReactive;
+
+static void ParticlesSetup(bool reactive) {
+  pReactive = reactive;
+  SetRandomSeed(1);
+  pTarget.position = (Vector2){400, 300};
+  InitReactiveState(&pState, &pTarget);
+  InitReactiveScheduler(&pScheduler);
+  AttachScheduler(&pState, &pScheduler);
+  for (int i = 0; i < particleCount; i++)
+    SpawnParticle(&pState, (Vector2){GetRandomValue(0, 800),
+                                     GetRandomValue(0, 600)});
+}
+
+static void ParticlesFrame(int f) {
+  pTarget.position.x = 400.0f + 300.0f * cosf((float)f * 0.02f);
+  pTarget.position.y = 300.0f + 200.0f * sinf((float)f * 0.03f);
+  if (f % 120 == 119)
+    for (int i = 0; i < 100; i++)
+      SpawnParticle(&pState, pTarget.position);
+  if (f % 180 == 179)
+    DespawnParticles(&pState, 100);
+
+  if (pReactive) {
+    SetState(&pState);
+    FlushScheduledStates(&pScheduler);
+  } else {
+    for (size_t i = 0; i < sm_count(particles); i++)
+      StepParticle(&pTarget, &particles.data[i]);
+  }
+}
+
+static double ParticlesTeardown(void) {
+  double sum = 0;
+  for (size_t i = 0; i < sm_count(particles); i++)
+    sum += particles.data[i].position.x * 3 + particles.data[i].position.y;
+  CleanupReactiveState(&pState);
+  CleanupReactiveScheduler(&pScheduler);
+  sm_free(particles);
+  return sum;
+}
+
+// --- Snake ---
+
+static GameState game;
+static ReactiveState sState;
+static bool sReactive;
+static unsigned char sGrid[ROWS][COLS];
+static char sScoreText[50];
+static double sDrawn;
+
+// What DrawGame puts on screen, into a cell grid and a string
+static void SnakeView(void *data, void *ctx) {
+  GameState *s = (GameState *)data;
+  (void)ctx;
+  memset(sGrid, 0, sizeof(sGrid));
+  if (s->gameOver) {
+    snprintf(sScoreText, sizeof(sScoreText), "Final Score: %d", s->score);
+  } else {
+    sGrid[(int)s->food.y][(int)s->food.x] = 3;
+    for (int i = 0; i < s->snakeLength; i++)
+      sGrid[(int)s->snake[i].y][(int)s->snake[i].x] = (i == 0) ? 1 : 2;
+    snprintf(sScoreText, sizeof(sScoreText), "Score: %d", s->score);
+  }
+  sDrawn += s->snakeLength + strlen(sScoreText);
+}
+
+static void SnakeSetup(bool reactive) {
+  sReactive = reactive;
+  sDrawn = 0;
+  SetRandomSeed(2);
+  Action_InitGame(&game);
+  InitReactiveState(&sState, &game);
+  Subscribe(&sState, SnakeView, NULL);
+}
+
+// Head for the food, x first; a refused 180 turn just keeps going
+static void SnakeAutopilot(GameState *s) {
+  Vector2 head = s->snake[0];
+  if (s->food.x != head.x)
+    Action_ChangeDirection(s, (Vector2){s->food.x > head.x ? 1 : -1, 0});
+  else
+    Action_ChangeDirection(s, (Vector2){0, s->food.y > head.y ? 1 : -1});
+}
+
+static void SnakeFrame(int f) {
+  (void)f;
+  if (game.gameOver)
+    Action_InitGame(&game);
+  SnakeAutopilot(&game);
+  Action_Tick(&game);
+  if (sReactive)
+    SetState(&sState);
+  else
+    SnakeView(&game, NULL);
+}
+
+static double SnakeTeardown(void) {
+  CleanupReactiveState(&sState);
+  return sDrawn + game.score;
+}
+
+// --- Calculator ---
+
+static const char calcScript[] = "12+34*5=C7.5/3=-2=*4.25=C9/0=C";
+
+static CalcState calc;
+static ReactiveState cState;
+static bool cReactive;
+static char cScreen[MAX_INPUT_CHARS + 1];
+static double cShown;
+
+// What DrawCalculator puts in the display
+static void CalculatorView(void *data, void *ctx) {
+  CalcState *s = (CalcState *)data;
+  (void)ctx;
+  snprintf(cScreen, sizeof(cScreen), "%s", s->displayBuffer);
+  cShown += strlen(cScreen) + (double)atof(cScreen);
+}
+
+static void CalculatorSetup(bool reactive) {
+  cReactive = reactive;
+  cShown = 0;
+  InitCalcState(&calc);
+  InitReactiveState(&cState, &calc);
+  Subscribe(&cState, CalculatorView, NULL);
+}
+
+static void CalculatorFrame(int f) {
+  char key = calcScript[f % (int)(sizeof(calcScript) - 1)];
+  if (Action_Press(&calc, key)) {
+    if (cReactive)
+      SetState(&cState);
+    else
+      CalculatorView(&calc, NULL);
+  }
+}
+
+static double CalculatorTeardown(void) {
+  CleanupReactiveState(&cState);
+  return cShown;
+}
+
+// --- Driver ---
+
+typedef struct {
+  const char *name;
+  void (*setup)(bool reactive);
+  void (*frame)(int f);
+  double (*teardown)(void); // returns a checksum of the final state
+} Scenario;
+
+static int CompareDouble(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static double Percentile(const double *sorted, int n, double q) {
+  return sorted[(int)(q * (n - 1))];
+}
+
+// Runs one scenario for `frames` frames; prints its percentiles
+static double Run(const Scenario *sc, bool reactive, int frames,
+                  double *times) {
+  sc->setup(reactive);
+  for (int f = 0; f < frames; f++) {
+    double t0 = now_sec();
+    sc->frame(f);
+    times[f] = (now_sec() - t0) * 1e6;
+  }
+  double checksum = sc->teardown();
+
+  double total = 0;
+  for (int f = 0; f < frames; f++)
+    total += times[f];
+  qsort(times, frames, sizeof(double), CompareDouble);
+  printf("  %-11s %-9s %9.2f %9.2f %9.2f %9.2f %9.2f\n", sc->name,
+         reactive ? "reactive" : "plain", total / frames,
+         Percentile(times, frames, 0.50), Percentile(times, frames, 0.90),
+         Percentile(times, frames, 0.99), times[frames - 1]);
+  return checksum;
+}
+
+int main(int argc, char **argv) {
+  int frames = argc > 1 ? atoi(argv[1]) : 20000;
+  if (argc > 2)
+    particleCount = atoi(argv[2]);
+  if (frames < 1)
+    frames = 1;
+
+  static const Scenario scenarios[] = {
+      {"particles", ParticlesSetup, ParticlesFrame, ParticlesTeardown},
+      {"snake", SnakeSetup, SnakeFrame, SnakeTeardown},
+      {"calculator", CalculatorSetup, CalculatorFrame, CalculatorTeardown},
+  };
+  double *times = (double *)malloc(frames * sizeof(double));
+  printf("%d frames, %d particles; update time per frame in us\n", frames,
+         particleCount);
+  printf("  %-11s %-9s %9s %9s %9s %9s %9s\n", "scenario", "mode", "mean",
+         "p50", "p90", "p99", "max");
+  for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+    double reactive = Run(&scenarios[i], true, frames, times);
+    double plain = Run(&scenarios[i], false, frames, times);
+    assert(reactive == plain);
+    (void)reactive;
+    (void)plain;
+  }
+  free(times);
+  return 0;
+}
@@ -0,0 +1,49 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+// The raylib types and helpers the demos' update logic uses. Normally
+// that is raylib.h itself; built with -DHEADLESS (no window, no GPU, no
+// raylib to link) it is this minimal stand-in, so the same logic headers
+// compile into headless_bench.c.
+
+#ifndef HEADLESS
+#include "raylib.h"
+#else
+
+#include <stdbool.h>
+
+typedef struct Vector2 {
+  float x;
+  float y;
+} Vector2;
+
+typedef struct Color {
+  unsigned char r;
+  unsigned char g;
+  unsigned char b;
+  unsigned char a;
+} Color;
+
+// Deterministic xorshift, so headless runs are repeatable
+static unsigned int headlessSeed = 2463534242u;
+
+static inline void SetRandomSeed(unsigned int seed) {
+  headlessSeed = seed ? seed : 2463534242u;
+}
+
+// Random int in [min, max], like raylib's
+static inline int GetRandomValue(int min, int max) {
+  if (min > max) {
+    int tmp = min;
+    min = max;
+    max = tmp;
+  }
+  headlessSeed ^= headlessSeed << 13;
+  headlessSeed ^= headlessSeed >> 17;
+  headlessSeed ^= headlessSeed << 5;
+  return min + (int)(headlessSeed % (unsigned int)(max - min + 1));
+}
+
+#endif // HEADLESS
+
+#endif // HEADLESS_H
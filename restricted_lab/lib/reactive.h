@@ -1,8 +1,16 @@
 #ifndef REACTIVE_H
 #define REACTIVE_H
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+// Define REACTIVE_THREADS (and build with -pthread) for parallel Notify:
+// see EnableParallelNotify
+#ifdef REACTIVE_THREADS
+#include <pthread.h>
+#endif
 
 // --- Reactive Infrastructure ---
 
@@ -10,27 +18,87 @@
 // context
 typedef void (*ObserverCallback)(void *subjectData, void *observerContext);
 
+// Observer flags. Under parallel Notify, observers are assumed thread-safe
+// unless flagged; flagged ones always run on the notifying thread.
+enum { OBSERVER_NOT_THREAD_SAFE = 1 << 0 };
+
 typedef struct {
   ObserverCallback callback;
   void *context;
+  int flags;
 } ObserverEntry;
 
+// Bulk observer: one call per Notify with every context subscribed under
+// that callback, in one contiguous array, so the callback can loop (and
+// vectorize) instead of paying an indirect call per observer
+typedef void (*BulkObserverCallback)(void *subjectData, void *const *contexts,
+                                     int count);
+
+typedef struct {
+  BulkObserverCallback callback;
+  void **contexts;
+  int count;
+  int capacity;
+  int flags;
+} BulkObserverGroup;
+
+typedef struct ReactiveScheduler ReactiveScheduler;
+typedef struct ReactiveWorkerPool ReactiveWorkerPool;
+
 typedef struct {
   void *data;
   ObserverEntry *observers;
   int observerCount;
   int observerCapacity;
+  BulkObserverGroup *bulk;
+  int bulkCount;
+  int bulkCapacity;
+  ReactiveScheduler *scheduler; // SetState defers to it when set
+  bool scheduled;               // already queued on the scheduler
+  ReactiveWorkerPool *workers;  // parallel Notify, when set
+  int parallelThreshold;        // ... from this many observers up
+  int callerOnlyCount;          // flagged observers and bulk groups
 } ReactiveState;
 
+// Collects states changed during a frame; each is notified once at the
+// next FlushScheduledStates however many times SetState ran on it
+struct ReactiveScheduler {
+  ReactiveState **pending;
+  int count;
+  int capacity;
+};
+
 static inline void InitReactiveState(ReactiveState *state, void *data) {
   state->data = data;
   state->observers = NULL;
   state->observerCount = 0;
   state->observerCapacity = 0;
+  state->bulk = NULL;
+  state->bulkCount = 0;
+  state->bulkCapacity = 0;
+  state->scheduler = NULL;
+  state->scheduled = false;
+  state->workers = NULL;
+  state->parallelThreshold = 0;
+  state->callerOnlyCount = 0;
 }
 
-static inline void Subscribe(ReactiveState *state, ObserverCallback callback,
-                             void *context) {
+// Makes room for one more element in a realloc'd array. Returns the
+// (possibly moved) array, or NULL on failure with the old one untouched.
+static inline void *ReactiveGrow(void *items, int count, int *capacity,
+                                 size_t elemSize) {
+  if (count < *capacity)
+    return items;
+  int newCapacity = (*capacity == 0) ? 4 : *capacity * 2;
+  void *grown = realloc(items, newCapacity * elemSize);
+  if (grown)
+    *capacity = newCapacity;
+  return grown;
+}
+
+static inline void SubscribeWithFlags(ReactiveState *state,
+                                      ObserverCallback callback, void *context,
+                                      int flags) {
   if (state->observerCount >= state->observerCapacity) {
     int newCapacity =
         (state->observerCapacity == 0) ? 4 : state->observerCapacity * 2;
@@ -46,26 +114,393 @@ static inline void Subscribe(ReactiveState *state, ObserverCallback callback,
 
   state->observers[state->observerCount].callback = callback;
   state->observers[state->observerCount].context = context;
+  state->observers[state->observerCount].flags = flags;
   state->observerCount++;
+  if (flags & OBSERVER_NOT_THREAD_SAFE)
+    state->callerOnlyCount++;
 }
 
-static inline void Notify(ReactiveState *state) {
-  for (int i = 0; i < state->observerCount; i++) {
-    if (state->observers[i].callback) {
-      state->observers[i].callback(state->data, state->observers[i].context);
+static inline void Subscribe(ReactiveState *state, ObserverCallback callback,
+                             void *context) {
+  SubscribeWithFlags(state, callback, context, 0);
+}
+
+// The bulk group for callback, or NULL if nothing subscribed under it
+static inline BulkObserverGroup *FindBulkGroup(ReactiveState *state,
+                                               BulkObserverCallback callback) {
+  for (int i = 0; i < state->bulkCount; i++)
+    if (state->bulk[i].callback == callback)
+      return &state->bulk[i];
+  return NULL;
+}
+
+// Adds context to the bulk group for callback (created on first use). A
+// group flagged OBSERVER_NOT_THREAD_SAFE by any subscription stays so.
+static inline void SubscribeBulkWithFlags(ReactiveState *state,
+                                          BulkObserverCallback callback,
+                                          void *context, int flags) {
+  BulkObserverGroup *group = FindBulkGroup(state, callback);
+  if (!group) {
+    BulkObserverGroup *groups =
+        (BulkObserverGroup *)ReactiveGrow(state->bulk, state->bulkCount,
+                                          &state->bulkCapacity,
+                                          sizeof(BulkObserverGroup));
+    if (!groups) {
+      fprintf(stderr, "Error: Failed to allocate memory for observers\n");
+      return;
     }
+    state->bulk = groups;
+    group = &state->bulk[state->bulkCount++];
+    group->callback = callback;
+    group->contexts = NULL;
+    group->count = 0;
+    group->capacity = 0;
+    group->flags = 0;
+  }
+  if ((flags & OBSERVER_NOT_THREAD_SAFE) &&
+      !(group->flags & OBSERVER_NOT_THREAD_SAFE)) {
+    group->flags |= OBSERVER_NOT_THREAD_SAFE;
+    state->callerOnlyCount++;
   }
+  void **contexts = (void **)ReactiveGrow(group->contexts, group->count,
+                                          &group->capacity, sizeof(void *));
+  if (!contexts) {
+    fprintf(stderr, "Error: Failed to allocate memory for observers\n");
+    return;
+  }
+  group->contexts = contexts;
+  group->contexts[group->count++] = context;
 }
 
-static inline void SetState(ReactiveState *state) { Notify(state); }
+static inline void SubscribeBulk(ReactiveState *state,
+                                 BulkObserverCallback callback,
+                                 void *context) {
+  SubscribeBulkWithFlags(state, callback, context, 0);
+}
+
+// Drops contexts [first, first + n) from callback's bulk group. The rest
+// keep their subscription order, so a group filled as entities spawn
+// stays oldest-first. Not to be called while the state is notifying.
+static inline void UnsubscribeBulkRange(ReactiveState *state,
+                                        BulkObserverCallback callback,
+                                        int first, int n) {
+  BulkObserverGroup *group = FindBulkGroup(state, callback);
+  if (!group || first < 0 || n <= 0 || first >= group->count)
+    return;
+  if (n > group->count - first)
+    n = group->count - first;
+  memmove(&group->contexts[first], &group->contexts[first + n],
+          (group->count - first - n) * sizeof(void *));
+  group->count -= n;
+}
+
+static inline void UnsubscribeBulk(ReactiveState *state,
+                                   BulkObserverCallback callback,
+                                   void *context) {
+  BulkObserverGroup *group = FindBulkGroup(state, callback);
+  if (!group)
+    return;
+  for (int i = 0; i < group->count; i++) {
+    if (group->contexts[i] == context) {
+      UnsubscribeBulkRange(state, callback, i, 1);
+      return;
+    }
+  }
+}
+
+// Runs slice `part` of `parts` of every observer list: a contiguous range
+// of the observers and of each bulk group's contexts. With skipUnsafe the
+// observers flagged OBSERVER_NOT_THREAD_SAFE are left out.
+static inline void NotifySlice(ReactiveState *state, int part, int parts,
+                               bool skipUnsafe) {
+  long long n = state->observerCount;
+  int lo = (int)(n * part / parts), hi = (int)(n * (part + 1) / parts);
+  for (int i = lo; i < hi; i++) {
+    ObserverEntry *entry = &state->observers[i];
+    if (!entry->callback)
+      continue;
+    if (skipUnsafe && (entry->flags & OBSERVER_NOT_THREAD_SAFE))
+      continue;
+    entry->callback(state->data, entry->context);
+  }
+  for (int i = 0; i < state->bulkCount; i++) {
+    BulkObserverGroup *group = &state->bulk[i];
+    if (skipUnsafe && (group->flags & OBSERVER_NOT_THREAD_SAFE))
+      continue;
+    n = group->count;
+    lo = (int)(n * part / parts);
+    hi = (int)(n * (part + 1) / parts);
+    if (hi > lo)
+      group->callback(state->data, group->contexts + lo, hi - lo);
+  }
+}
+
+#ifdef REACTIVE_THREADS
+
+// --- Parallel dispatch ---
+// `threadCount` workers plus the notifying thread split the observers
+// into equal slices. Notify wakes the workers, runs its own slice, waits
+// until all have finished (a barrier on `remaining`), then runs the
+// flagged observers. Observers on a worker may call Notify; while the
+// pool is busy that Notify just runs serially.
+
+typedef struct {
+  ReactiveWorkerPool *pool;
+  int index;
+} ReactiveWorker;
+
+struct ReactiveWorkerPool {
+  pthread_t *threads;
+  ReactiveWorker *workers;
+  int threadCount;
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  pthread_cond_t done;
+  unsigned long generation; // bumped for each job
+  int remaining;            // workers still in the current job
+  bool busy;
+  bool quit;
+  ReactiveState *state; // current job
+};
+
+static inline void *ReactiveWorkerMain(void *arg) {
+  ReactiveWorker *worker = (ReactiveWorker *)arg;
+  ReactiveWorkerPool *pool = worker->pool;
+  unsigned long seen = 0;
+  for (;;) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->generation == seen && !pool->quit)
+      pthread_cond_wait(&pool->wake, &pool->lock);
+    if (pool->quit) {
+      pthread_mutex_unlock(&pool->lock);
+      return NULL;
+    }
+    seen = pool->generation;
+    ReactiveState *state = pool->state;
+    pthread_mutex_unlock(&pool->lock);
+
+    NotifySlice(state, worker->index, pool->threadCount + 1, true);
+
+    pthread_mutex_lock(&pool->lock);
+    if (--pool->remaining == 0)
+      pthread_cond_signal(&pool->done);
+    pthread_mutex_unlock(&pool->lock);
+  }
+}
+
+static inline void CleanupReactiveWorkers(ReactiveWorkerPool *pool);
+
+// Starts threadCount workers. On failure the workers that did start are
+// stopped again and everything is released: there is nothing to clean up.
+static inline bool InitReactiveWorkers(ReactiveWorkerPool *pool,
+                                       int threadCount) {
+  pool->threadCount = 0;
+  pool->threads = (pthread_t *)malloc(threadCount * sizeof(pthread_t));
+  pool->workers =
+      (ReactiveWorker *)malloc(threadCount * sizeof(ReactiveWorker));
+  if (!pool->threads || !pool->workers) {
+    free(pool->threads);
+    free(pool->workers);
+    pool->threads = NULL;
+    pool->workers = NULL;
+    return false;
+  }
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->wake, NULL);
+  pthread_cond_init(&pool->done, NULL);
+  pool->generation = 0;
+  pool->remaining = 0;
+  pool->busy = false;
+  pool->quit = false;
+  pool->state = NULL;
+  pool->threadCount = 0;
+  for (int i = 0; i < threadCount; i++) {
+    pool->workers[i].pool = pool;
+    pool->workers[i].index = i;
+    if (pthread_create(&pool->threads[i], NULL, ReactiveWorkerMain,
+                       &pool->workers[i]) != 0)
+      break;
+    pool->threadCount++;
+  }
+  if (pool->threadCount < threadCount) {
+    CleanupReactiveWorkers(pool); // quits and joins the ones running
+    return false;
+  }
+  return true;
+}
+
+static inline void CleanupReactiveWorkers(ReactiveWorkerPool *pool) {
+  pthread_mutex_lock(&pool->lock);
+  pool->quit = true;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+  for (int i = 0; i < pool->threadCount; i++)
+    pthread_join(pool->threads[i], NULL);
+  pthread_mutex_destroy(&pool->lock);
+  pthread_cond_destroy(&pool->wake);
+  pthread_cond_destroy(&pool->done);
+  free(pool->threads);
+  free(pool->workers);
+  pool->threads = NULL;
+  pool->workers = NULL;
+  pool->threadCount = 0;
+}
+
+// Notify runs on the pool once the state has at least `threshold`
+// observers (bulk contexts count one each); below that it stays serial
+static inline void EnableParallelNotify(ReactiveState *state,
+                                        ReactiveWorkerPool *pool,
+                                        int threshold) {
+  state->workers = pool;
+  state->parallelThreshold = threshold;
+}
+
+static inline bool NotifyParallel(ReactiveState *state) {
+  ReactiveWorkerPool *pool = state->workers;
+  pthread_mutex_lock(&pool->lock);
+  if (pool->busy || pool->threadCount == 0) {
+    pthread_mutex_unlock(&pool->lock);
+    return false;
+  }
+  pool->busy = true;
+  pool->state = state;
+  pool->remaining = pool->threadCount;
+  pool->generation++;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+
+  NotifySlice(state, pool->threadCount, pool->threadCount + 1, true);
+
+  pthread_mutex_lock(&pool->lock);
+  while (pool->remaining > 0)
+    pthread_cond_wait(&pool->done, &pool->lock);
+  pool->busy = false;
+  pthread_mutex_unlock(&pool->lock);
+
+  if (state->callerOnlyCount > 0) {
+    for (int i = 0; i < state->observerCount; i++) {
+      ObserverEntry *entry = &state->observers[i];
+      if (entry->callback && (entry->flags & OBSERVER_NOT_THREAD_SAFE))
+        entry->callback(state->data, entry->context);
+    }
+    for (int i = 0; i < state->bulkCount; i++) {
+      BulkObserverGroup *group = &state->bulk[i];
+      if (group->flags & OBSERVER_NOT_THREAD_SAFE)
+        group->callback(state->data, group->contexts, group->count);
+    }
+  }
+  return true;
+}
+
+#endif // REACTIVE_THREADS
+
+static inline void Notify(ReactiveState *state) {
+#ifdef REACTIVE_THREADS
+  if (state->workers) {
+    int total = state->observerCount;
+    for (int i = 0; i < state->bulkCount; i++)
+      total += state->bulk[i].count;
+    if (total >= state->parallelThreshold && NotifyParallel(state))
+      return;
+  }
+#endif
+  NotifySlice(state, 0, 1, false);
+}
+
+// --- Deferred notification ---
+
+static inline void InitReactiveScheduler(ReactiveScheduler *sched) {
+  sched->pending = NULL;
+  sched->count = 0;
+  sched->capacity = 0;
+}
+
+// From now on SetState(state) queues instead of notifying
+static inline void AttachScheduler(ReactiveState *state,
+                                   ReactiveScheduler *sched) {
+  state->scheduler = sched;
+}
+
+static inline void ScheduleState(ReactiveScheduler *sched,
+                                 ReactiveState *state) {
+  if (state->scheduled)
+    return;
+  ReactiveState **pending = (ReactiveState **)ReactiveGrow(
+      sched->pending, sched->count, &sched->capacity, sizeof(ReactiveState *));
+  if (!pending) {
+    Notify(state); // can't defer; don't lose the update
+    return;
+  }
+  sched->pending = pending;
+  state->scheduled = true;
+  sched->pending[sched->count++] = state;
+}
+
+// Notifies every queued state once, in the order they were first set. A
+// state set again by an observer during the flush is queued behind and
+// notified in the same flush.
+static inline void FlushScheduledStates(ReactiveScheduler *sched) {
+  for (int i = 0; i < sched->count; i++) {
+    ReactiveState *state = sched->pending[i];
+    state->scheduled = false;
+    Notify(state);
+  }
+  sched->count = 0;
+}
+
+static inline void SetState(ReactiveState *state) {
+  if (state->scheduler)
+    ScheduleState(state->scheduler, state);
+  else
+    Notify(state);
+}
+
+static inline void CleanupReactiveScheduler(ReactiveScheduler *sched) {
+  free(sched->pending);
+  sched->pending = NULL;
+  sched->count = 0;
+  sched->capacity = 0;
+}
+
+// Takes a queued state back off its scheduler. Searches from the back: a
+// state set again during a flush also has an old, already notified entry
+// in front, and only the newest one is still pending.
+static inline void UnscheduleState(ReactiveScheduler *sched,
+                                   ReactiveState *state) {
+  if (!state->scheduled)
+    return;
+  for (int i = sched->count - 1; i >= 0; i--) {
+    if (sched->pending[i] == state) {
+      memmove(&sched->pending[i], &sched->pending[i + 1],
+              (sched->count - i - 1) * sizeof(ReactiveState *));
+      sched->count--;
+      break;
+    }
+  }
+  state->scheduled = false;
+}
 
+// Also takes the state off its scheduler's queue, so a later flush never
+// notifies freed observers
 static inline void CleanupReactiveState(ReactiveState *state) {
+  if (state->scheduler)
+    UnscheduleState(state->scheduler, state);
   if (state->observers) {
     free(state->observers);
     state->observers = NULL;
   }
   state->observerCount = 0;
   state->observerCapacity = 0;
+  for (int i = 0; i < state->bulkCount; i++)
+    free(state->bulk[i].contexts);
+  free(state->bulk);
+  state->bulk = NULL;
+  state->bulkCount = 0;
+  state->bulkCapacity = 0;
+  state->scheduler = NULL;
+  state->scheduled = false;
+  state->workers = NULL;
+  state->callerOnlyCount = 0;
 }
 
 #endif // REACTIVE_H
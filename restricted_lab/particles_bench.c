@@ -0,0 +1,128 @@
+/*
+ * particles_bench.c — headless particles_reactive at 1M particles:
+ * serial vs parallel Notify
+ *
+ * Compile:
+ *   gcc -std=c11 -O2 -pthread -DHEADLESS -DREACTIVE_THREADS \
+ *       particles_bench.c -o particles_bench -lm
+ *
+ * Run:
+ *   ./particles_bench [particles] [frames]     (default 1000000 60)
+ *
+ * The update from particles_logic.h (each particle steps towards a
+ * target that circles the screen), with no window. Particles are observed
+ * one by one (Subscribe) and as one bulk group (SubscribeBulk); each is
+ * notified serially and then on 1..N workers, N = online CPUs - 1 (at
+ * least 1; the notifying thread takes a slice too). Positions must come
+ * out bit-identical however the work is split.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "particles_logic.h"
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void ParticleObserver(void *subjectData, void *observerContext) {
+  Particle *p = sm_get(particles, (sm_handle_t)(uintptr_t)observerContext);
+  if (p)
+    StepParticle((TargetState *)subjectData, p);
+}
+
+static Particle RandomParticle(unsigned *s) {
+  *s = *s * 1664525u + 1013904223u;
+  return (Particle){{(float)(*s >> 8 & 1023) * 0.78f,
+                     (float)(*s >> 18 & 1023) * 0.58f},
+                    {255, 255, 255, 200},
+                    (float)(2 + (*s >> 28) % 4)};
+}
+
+static void Spawn(int count) {
+  unsigned s = 12345;
+  for (int i = 0; i < count; i++) {
+    sm_handle_t h;
+    sm_insert(particles, h, RandomParticle(&s));
+    assert(h != SM_NULL_HANDLE);
+  }
+}
+
+// Back to the spawn positions; handles (and so subscriptions) stay valid
+static void Reset(void) {
+  unsigned s = 12345;
+  for (size_t i = 0; i < sm_count(particles); i++)
+    particles.data[i] = RandomParticle(&s);
+}
+
+// Runs `frames` notifies; returns ms per frame
+static double Run(ReactiveState *state, TargetState *target, int frames) {
+  double t0 = now_sec();
+  for (int f = 0; f < frames; f++) {
+    target->position.x = 400.0f + 300.0f * cosf((float)f * 0.05f);
+    target->position.y = 300.0f + 200.0f * sinf((float)f * 0.05f);
+    SetState(state);
+  }
+  return (now_sec() - t0) * 1e3 / frames;
+}
+
+static double Checksum(void) {
+  double sum = 0;
+  for (size_t i = 0; i < sm_count(particles); i++)
+    sum += particles.data[i].position.x * 3 + particles.data[i].position.y;
+  return sum;
+}
+
+static void Bench(const char *mode, bool bulk, int frames, int maxThreads) {
+  TargetState target = {{0, 0}};
+  ReactiveState state;
+  InitReactiveState(&state, &target);
+  Reset();
+  for (size_t i = 0; i < sm_count(particles); i++) {
+    void *ctx = (void *)(uintptr_t)sm_handle_at(particles, i);
+    if (bulk)
+      SubscribeBulk(&state, ParticlesObserver, ctx);
+    else
+      Subscribe(&state, ParticleObserver, ctx);
+  }
+
+  double serial = Run(&state, &target, frames);
+  double expect = Checksum();
+  printf("  %-6s serial       %8.2f ms/frame\n", mode, serial);
+
+  for (int threads = 1; threads <= maxThreads; threads++) {
+    ReactiveWorkerPool pool;
+    if (!InitReactiveWorkers(&pool, threads)) {
+      fprintf(stderr, "could not start %d workers\n", threads);
+      break;
+    }
+    EnableParallelNotify(&state, &pool, 4096);
+    Reset();
+    double t = Run(&state, &target, frames);
+    assert(Checksum() == expect);
+    printf("  %-6s %d worker%s    %8.2f ms/frame   %5.2fx\n", mode, threads,
+           threads == 1 ? " " : "s", t, serial / t);
+    state.workers = NULL;
+    CleanupReactiveWorkers(&pool);
+  }
+  CleanupReactiveState(&state);
+}
+
+int main(int argc, char **argv) {
+  int count = argc > 1 ? atoi(argv[1]) : 1000000;
+  int frames = argc > 2 ? atoi(argv[2]) : 60;
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  int maxThreads = cpus > 2 ? (int)cpus - 1 : 1;
+  printf("%d particles, %d frames, %ld CPU%s online\n", count, frames, cpus,
+         cpus == 1 ? "" : "s");
+  Spawn(count);
+  Bench("each", false, frames, maxThreads);
+  Bench("bulk", true, frames, maxThreads);
+  sm_free(particles);
+  return 0;
+}
@@ -0,0 +1,86 @@
+#ifndef PARTICLES_LOGIC_H
+#define PARTICLES_LOGIC_H
+
+// Particle state and update, free of rendering: shared by
+// particles_reactive.c, particles_bench.c and headless_bench.c
+
+#include "../lib/slotmap.h"
+#include "lib/headless.h"
+#include "lib/reactive.h"
+#include <math.h>
+#include <stdint.h>
+
+// --- Domain ---
+
+typedef struct {
+  Vector2 position;
+} TargetState;
+
+typedef struct {
+  Vector2 position;
+  Color color;
+  float speed;
+} Particle;
+
+// Particles live in a slot map: observers hold a handle, not a pointer, so
+// spawning more particles (which grows the storage) or despawning some
+// never leaves an observer pointing at freed or reused memory.
+static sm_t(Particle) particles;
+
+// Move particle towards target
+static inline void StepParticle(const TargetState *target, Particle *p) {
+  Vector2 dir = {target->position.x - p->position.x,
+                 target->position.y - p->position.y};
+  float dist = sqrtf(dir.x * dir.x + dir.y * dir.y);
+
+  if (dist > 1.0f) {
+    dir.x /= dist;
+    dir.y /= dist;
+    p->position.x += dir.x * p->speed;
+    p->position.y += dir.y * p->speed;
+  }
+}
+
+// Bulk observer: called once per notify with every particle's handle in
+// one array, so moving 1000 particles is one loop instead of 1000
+// indirect calls
+static inline void ParticlesObserver(void *subjectData, void *const *contexts,
+                                     int count) {
+  TargetState *target = (TargetState *)subjectData;
+  for (int i = 0; i < count; i++) {
+    Particle *p = sm_get(particles, (sm_handle_t)(uintptr_t)contexts[i]);
+    if (!p)
+      continue; // removed from the slot map behind DespawnParticles' back
+    StepParticle(target, p);
+  }
+}
+
+static inline void SpawnParticle(ReactiveState *appState, Vector2 position) {
+  Particle p = {position,
+                (Color){GetRandomValue(50, 255), GetRandomValue(50, 255),
+                        GetRandomValue(50, 255), 200},
+                GetRandomValue(2, 5)};
+  sm_handle_t h;
+  sm_insert(particles, h, p);
+  if (h == SM_NULL_HANDLE)
+    return;
+
+  // Subscribe with CONTEXT! (the handle, packed into the pointer)
+  SubscribeBulk(appState, ParticlesObserver, (void *)(uintptr_t)h);
+}
+
+// Right click in the demo: despawn the oldest `count`. ParticlesObserver's
+// contexts are in spawn order, so the oldest are its first `count`; they
+// leave the slot map and the bulk group together.
+static inline void DespawnParticles(ReactiveState *appState, int count) {
+  BulkObserverGroup *group = FindBulkGroup(appState, ParticlesObserver);
+  if (!group)
+    return;
+  if (count > group->count)
+    count = group->count;
+  for (int i = 0; i < count; i++)
+    sm_remove(particles, (sm_handle_t)(uintptr_t)group->contexts[i]);
+  UnsubscribeBulkRange(appState, ParticlesObserver, 0, count);
+}
+
+#endif // PARTICLES_LOGIC_H
@@ -1,39 +1,9 @@
 #include "lib/reactive.h"
+#include "particles_logic.h"
 #include "raylib.h"
-#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-// --- Domain ---
-
-typedef struct {
-  Vector2 position;
-} TargetState;
-
-typedef struct {
-  Vector2 position;
-  Color color;
-  float speed;
-} Particle;
-
-// Now the observer receives the particle context!
-void ParticleObserver(void *subjectData, void *observerContext) {
-  TargetState *target = (TargetState *)subjectData;
-  Particle *p = (Particle *)observerContext;
-
-  // Move particle towards target
-  Vector2 dir = {target->position.x - p->position.x,
-                 target->position.y - p->position.y};
-  float dist = sqrtf(dir.x * dir.x + dir.y * dir.y);
-
-  if (dist > 1.0f) {
-    dir.x /= dist;
-    dir.y /= dist;
-    p->position.x += dir.x * p->speed;
-    p->position.y += dir.y * p->speed;
-  }
-}
-
 int main(void) {
   const int screenWidth = 800;
   const int screenHeight = 600;
@@ -45,21 +15,16 @@ int main(void) {
   ReactiveState appState;
   InitReactiveState(&appState, &target);
 
+  // SetState only queues; observers run once per frame at the flush
+  ReactiveScheduler scheduler;
+  InitReactiveScheduler(&scheduler);
+  AttachScheduler(&appState, &scheduler);
+
   // Create many particles
   const int PARTICLE_COUNT = 1000;
-  Particle *particles = (Particle *)malloc(PARTICLE_COUNT * sizeof(Particle));
-
-  for (int i = 0; i < PARTICLE_COUNT; i++) {
-    particles[i].position = (Vector2){GetRandomValue(0, screenWidth),
-                                      GetRandomValue(0, screenHeight)};
-    particles[i].color =
-        (Color){GetRandomValue(50, 255), GetRandomValue(50, 255),
-                GetRandomValue(50, 255), 200};
-    particles[i].speed = GetRandomValue(2, 5);
-
-    // Subscribe with CONTEXT!
-    Subscribe(&appState, ParticleObserver, &particles[i]);
-  }
+  for (int i = 0; i < PARTICLE_COUNT; i++)
+    SpawnParticle(&appState, (Vector2){GetRandomValue(0, screenWidth),
+                                       GetRandomValue(0, screenHeight)});
 
   while (!WindowShouldClose()) {
     Vector2 mousePos = GetMousePosition();
@@ -67,26 +32,40 @@ int main(void) {
     // Update target
     target.position = mousePos;
 
+    // Left click spawns a burst (storage may grow), right click despawns
+    // the oldest 100 and unsubscribes them
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+      for (int i = 0; i < 100; i++)
+        SpawnParticle(&appState, mousePos);
+    }
+    if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT))
+      DespawnParticles(&appState, 100);
+
     // Notify all particles to update themselves based on new target
     // Note: In a real game loop, you'd probably update particles in a loop,
     // but here we are demonstrating the observer pattern driving the logic.
     SetState(&appState);
+    FlushScheduledStates(&scheduler);
 
     BeginDrawing();
     ClearBackground(RAYWHITE);
 
     // Draw Particles
-    for (int i = 0; i < PARTICLE_COUNT; i++) {
-      DrawPixelV(particles[i].position, particles[i].color);
+    for (size_t i = 0; i < sm_count(particles); i++) {
+      DrawPixelV(particles.data[i].position, particles.data[i].color);
     }
 
     DrawCircleV(target.position, 10, MAROON);
-    DrawText("1000 Observers tracking mouse!", 10, 10, 20, DARKGRAY);
+    DrawText(TextFormat("%d particles tracking mouse! (click: +100, right "
+                        "click: -100)",
+                        (int)sm_count(particles)),
+             10, 10, 20, DARKGRAY);
     EndDrawing();
   }
 
   CleanupReactiveState(&appState);
-  free(particles);
+  CleanupReactiveScheduler(&scheduler);
+  sm_free(particles);
   CloseWindow();
   return 0;
 }
@@ -0,0 +1,95 @@
+#ifndef SNAKE_LOGIC_H
+#define SNAKE_LOGIC_H
+
+// Snake game state and actions, free of rendering: shared by
+// snake_reactive.c and headless_bench.c
+
+#include "lib/headless.h"
+#include <stdbool.h>
+
+#define GRID_SIZE 20
+#define SCREEN_WIDTH 800
+#define SCREEN_HEIGHT 600
+#define COLS (SCREEN_WIDTH / GRID_SIZE)
+#define ROWS (SCREEN_HEIGHT / GRID_SIZE)
+#define MAX_SNAKE_LENGTH 400
+
+// --- Game State ---
+
+typedef struct {
+  Vector2 snake[MAX_SNAKE_LENGTH];
+  int snakeLength;
+  Vector2 food;
+  Vector2 direction;
+  bool gameOver;
+  int score;
+} GameState;
+
+// --- Actions ---
+
+static inline void Action_SpawnFood(GameState *s) {
+  // Simple random spawn, could overlap snake but fine for demo
+  s->food.x = GetRandomValue(0, COLS - 1);
+  s->food.y = GetRandomValue(0, ROWS - 1);
+}
+
+static inline void Action_InitGame(GameState *s) {
+  s->snakeLength = 3;
+  s->snake[0] = (Vector2){COLS / 2, ROWS / 2};
+  s->snake[1] = (Vector2){COLS / 2, ROWS / 2 + 1};
+  s->snake[2] = (Vector2){COLS / 2, ROWS / 2 + 2};
+  s->direction = (Vector2){0, -1}; // Moving Up
+  s->gameOver = false;
+  s->score = 0;
+  Action_SpawnFood(s);
+}
+
+static inline void Action_ChangeDirection(GameState *s, Vector2 newDir) {
+  // Prevent 180 degree turns
+  if (s->direction.x + newDir.x != 0 || s->direction.y + newDir.y != 0) {
+    s->direction = newDir;
+  }
+}
+
+static inline void Action_Tick(GameState *s) {
+  if (s->gameOver)
+    return;
+
+  // Move body
+  for (int i = s->snakeLength - 1; i > 0; i--) {
+    s->snake[i] = s->snake[i - 1];
+  }
+
+  // Move head
+  s->snake[0].x += s->direction.x;
+  s->snake[0].y += s->direction.y;
+
+  // Wall Collision
+  if (s->snake[0].x < 0 || s->snake[0].x >= COLS || s->snake[0].y < 0 ||
+      s->snake[0].y >= ROWS) {
+    s->gameOver = true;
+    return;
+  }
+
+  // Self Collision
+  for (int i = 1; i < s->snakeLength; i++) {
+    if (s->snake[0].x == s->snake[i].x && s->snake[0].y == s->snake[i].y) {
+      s->gameOver = true;
+      return;
+    }
+  }
+
+  // Food Collision
+  if (s->snake[0].x == s->food.x && s->snake[0].y == s->food.y) {
+    s->score += 10;
+    if (s->snakeLength < MAX_SNAKE_LENGTH) {
+      s->snakeLength++;
+      // New segment will be at the position of the last segment (will uncurl
+      // next tick)
+      s->snake[s->snakeLength - 1] = s->snake[s->snakeLength - 2];
+    }
+    Action_SpawnFood(s);
+  }
+}
+
+#endif // SNAKE_LOGIC_H
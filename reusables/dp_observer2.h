@@ -10,21 +10,40 @@ typedef void (*Observer)(void *);
 typedef struct {
   Observer *subs;
   size_t count;
+  size_t capacity;
 } Subject;
 
 static inline void subject_init(Subject *s) {
   s->subs = NULL;
   s->count = 0;
+  s->capacity = 0;
 }
 
-static inline void subject_attach(Subject *s, Observer o) {
-  s->subs = realloc(s->subs, sizeof(Observer) * (s->count + 1));
+// Capacity doubles, so n attaches cost O(n) copying in total. Returns 0
+// (and leaves the subject as it was) when out of memory.
+static inline int subject_attach(Subject *s, Observer o) {
+  if (s->count == s->capacity) {
+    size_t capacity = s->capacity ? s->capacity * 2 : 4;
+    Observer *subs = realloc(s->subs, sizeof(Observer) * capacity);
+    if (!subs)
+      return 0;
+    s->subs = subs;
+    s->capacity = capacity;
+  }
   s->subs[s->count++] = o;
+  return 1;
 }
 
+// Single-threaded: worker threads should hand their messages to one
+// notifying thread, e.g. through lib/eventbus_mt.h.
 static inline void subject_notify(Subject *s, void *msg) {
   for (size_t i = 0; i < s->count; i++)
     s->subs[i](msg);
 }
 
+static inline void subject_free(Subject *s) {
+  free(s->subs);
+  subject_init(s);
+}
+
 #endif
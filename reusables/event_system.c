@@ -1,14 +1,15 @@
 /**
  * Event-driven system with callbacks
+ *
+ * Subscriber lists grow as needed. For a version with queued, per-frame
+ * dispatch see lib/eventbus.h; lib/eventbus_mt.h adds lock-free posting
+ * from worker threads.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define MAX_EVENTS 10
-#define MAX_SUBSCRIBERS_PER_EVENT 5
-
 typedef enum {
   EVENT_BUTTON_PRESS,
   EVENT_TIMER_EXPIRED,
@@ -26,8 +27,9 @@ typedef struct {
 typedef void (*EventHandler)(const Event *);
 
 typedef struct {
-  EventHandler handlers[MAX_SUBSCRIBERS_PER_EVENT];
+  EventHandler *handlers;
   int handler_count;
+  int handler_capacity;
 } EventSubscribers;
 
 typedef struct {
@@ -40,7 +42,9 @@ EventSystem *event_system_create(void) {
     return NULL;
 
   for (int i = 0; i < EVENT_TYPE_COUNT; i++) {
+    es->subscribers[i].handlers = NULL;
     es->subscribers[i].handler_count = 0;
+    es->subscribers[i].handler_capacity = 0;
   }
 
   return es;
@@ -52,8 +56,15 @@ int event_system_subscribe(EventSystem *es, EventType type,
     return 0;
 
   EventSubscribers *subs = &es->subscribers[type];
-  if (subs->handler_count >= MAX_SUBSCRIBERS_PER_EVENT)
-    return 0;
+  if (subs->handler_count == subs->handler_capacity) {
+    int capacity = subs->handler_capacity ? subs->handler_capacity * 2 : 4;
+    EventHandler *handlers =
+        realloc(subs->handlers, capacity * sizeof(EventHandler));
+    if (!handlers)
+      return 0;
+    subs->handlers = handlers;
+    subs->handler_capacity = capacity;
+  }
 
   subs->handlers[subs->handler_count++] = handler;
   return 1;
@@ -69,7 +80,11 @@ void event_system_publish(EventSystem *es, const Event *event) {
   }
 }
 
-void event_system_destroy(EventSystem *es) { free(es); }
+void event_system_destroy(EventSystem *es) {
+  for (int i = 0; i < EVENT_TYPE_COUNT; i++)
+    free(es->subscribers[i].handlers);
+  free(es);
+}
 
 // Example event handlers
 void button_press_handler(const Event *event) {
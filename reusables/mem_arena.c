@@ -10,11 +10,14 @@ void arena_init(Arena *a, size_t cap) {
   a->used = 0;
 }
 
+// Fixed-capacity arena. For a growable one with alignment and
+// mark/rewind scopes see lib/arena.h.
 void *arena_alloc(Arena *a, size_t size) {
-  if (a->used + size > a->capacity)
-    abort(); // or grow
+  size = (size + 7) & ~(size_t)7; // align to 8 before the capacity check
+  if (size > a->capacity - a->used)
+    abort();
   void *p = a->base + a->used;
-  a->used += (size + 7) & ~7; // align to 8
+  a->used += size;
   return p;
 }
 
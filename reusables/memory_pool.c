@@ -1,41 +1,57 @@
-
 #include <stdio.h>
 #include <stdlib.h>
 
+// Fixed-size pool with an intrusive free list: each free block stores the
+// pointer to the next free block in its own first bytes, so allocation and
+// release are O(1) and no per-block flag array is needed.
+// Growable / debug / cross-thread version: lib/pool.h
+
+typedef struct FreeBlock {
+    struct FreeBlock *next;
+} FreeBlock;
+
 typedef struct MemoryBlock {
     void *memory;
     size_t blockSize;
     size_t numBlocks;
-    int *freeList;
+    FreeBlock *freeList;
 } MemoryBlock;
 
 // Initialize a memory pool
 void initializeMemoryPool(MemoryBlock *pool, size_t blockSize, size_t numBlocks) {
+    // Every block must be able to hold the free-list link
+    if (blockSize < sizeof(FreeBlock))
+        blockSize = sizeof(FreeBlock);
+    blockSize = (blockSize + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
     pool->memory = malloc(blockSize * numBlocks);
     pool->blockSize = blockSize;
     pool->numBlocks = numBlocks;
-    pool->freeList = (int *)malloc(numBlocks * sizeof(int));
+    pool->freeList = NULL;
 
-    for (size_t i = 0; i < numBlocks; i++) {
-        pool->freeList[i] = 1; // 1 means free
+    // Thread blocks back to front so the first allocation is block 0
+    for (size_t i = numBlocks; i-- > 0;) {
+        FreeBlock *block = (FreeBlock *)((char *)pool->memory + i * blockSize);
+        block->next = pool->freeList;
+        pool->freeList = block;
     }
 }
 
 // Allocate a block from the memory pool
 void *allocateBlock(MemoryBlock *pool) {
-    for (size_t i = 0; i < pool->numBlocks; i++) {
-        if (pool->freeList[i] == 1) {
-            pool->freeList[i] = 0; // Mark as used
-            return (char *)pool->memory + (i * pool->blockSize);
-        }
-    }
-    return NULL; // No free blocks
+    FreeBlock *block = pool->freeList;
+    if (!block)
+        return NULL; // No free blocks
+    pool->freeList = block->next;
+    return block;
 }
 
 // Free a block in the memory pool
 void freeBlock(MemoryBlock *pool, void *block) {
-    size_t index = ((char *)block - (char *)pool->memory) / pool->blockSize;
-    if (index < pool->numBlocks) {
-        pool->freeList[index] = 1; // Mark as free
+    size_t offset = (size_t)((char *)block - (char *)pool->memory);
+    if (offset < pool->blockSize * pool->numBlocks) {
+        FreeBlock *free_block = (FreeBlock *)block;
+        free_block->next = pool->freeList;
+        pool->freeList = free_block;
     }
 }
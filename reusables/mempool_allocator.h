@@ -3,8 +3,12 @@
 #ifndef MEMPOOL_H
 #define MEMPOOL_H
 
+#include <stddef.h>
 #include <stdlib.h>
 
+// Single-threaded bump allocator, no per-object free. For a general-purpose
+// thread-caching allocator with free/realloc see lib/slab_alloc.h.
+
 typedef struct {
   char *pool;
   size_t size;
@@ -20,10 +24,13 @@ static inline MemPool *mempool_new(size_t size) {
 }
 
 static inline void *mempool_alloc(MemPool *mp, size_t n) {
-  if (mp->used + n > mp->size)
+  // Keep every allocation aligned like malloc's
+  size_t align = _Alignof(max_align_t);
+  size_t start = (mp->used + align - 1) & ~(align - 1);
+  if (start > mp->size || n > mp->size - start)
     return NULL;
-  void *ptr = mp->pool + mp->used;
-  mp->used += n;
+  void *ptr = mp->pool + start;
+  mp->used = start + n;
   return ptr;
 }
 
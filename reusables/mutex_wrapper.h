@@ -1,15 +1,328 @@
-
 // mutex.h
+//
+// Mutex / RwLock for short critical sections.
+//
+// On Linux the lock word is a futex: an uncontended lock is one CAS, a
+// contended lock first spins with `pause` and exponential backoff (the
+// holder is usually about to release) and only then parks in the kernel.
+// Elsewhere, or with -DMUTEX_USE_PTHREAD, both types fall back to pthreads.
+//
+// RwLock prefers writers: once a writer is waiting, new readers queue up
+// behind it so a steady stream of readers cannot starve writers.
+//
+// Build with -DMUTEX_STATS to record acquisitions, contended acquisitions
+// and total/max wait time per lock (read with mutex_stats / rwlock_stats;
+// futex implementation only).
+//
+// Define _GNU_SOURCE before including any system header.
 #ifndef MUTEX_H
 #define MUTEX_H
 
 #include <pthread.h>
+#include <stdint.h>
+
+// syscall() and pthread_rwlock_* are hidden under -std=c11: the includer
+// defines _GNU_SOURCE (or _DEFAULT_SOURCE) before any system header
+#if defined(__GLIBC__) && !(defined(__USE_MISC) && defined(__USE_XOPEN2K))
+#error "mutex_wrapper.h: define _GNU_SOURCE before any system header"
+#endif
+
+#ifndef MUTEX_SPIN_LIMIT
+#define MUTEX_SPIN_LIMIT 64 // spin rounds before parking
+#endif
+
+#ifndef MUTEX_BACKOFF_MAX
+#define MUTEX_BACKOFF_MAX 64 // max `pause` instructions per spin round
+#endif
+
+typedef struct {
+  uint64_t acquisitions;
+  uint64_t contended; // acquisitions that missed the fast path
+  uint64_t wait_ns;   // total time spent in the slow path
+  uint64_t max_wait_ns;
+} LockStats;
+
+#if defined(__linux__) && !defined(MUTEX_USE_PTHREAD)
+
+#include <limits.h>
+#include <linux/futex.h>
+#include <stdatomic.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+static inline void mutex__cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+static inline void mutex__futex_wait(atomic_int *addr, int expected) {
+  syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+}
+
+static inline void mutex__futex_wake(atomic_int *addr, int count) {
+  syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+// Spin one backoff round; returns the doubled backoff for the next round
+static inline int mutex__spin_backoff(int backoff) {
+  for (int i = 0; i < backoff; i++)
+    mutex__cpu_relax();
+  return backoff < MUTEX_BACKOFF_MAX ? backoff * 2 : backoff;
+}
+
+#ifdef MUTEX_STATS
+typedef struct {
+  atomic_ullong acquisitions, contended, wait_ns, max_wait_ns;
+} LockStatsAtomic;
+
+static inline uint64_t lock_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static inline void lock_stats_fast(LockStatsAtomic *s) {
+  atomic_fetch_add_explicit(&s->acquisitions, 1, memory_order_relaxed);
+}
+
+static inline void lock_stats_slow(LockStatsAtomic *s, uint64_t start) {
+  uint64_t waited = lock_now_ns() - start;
+  atomic_fetch_add_explicit(&s->acquisitions, 1, memory_order_relaxed);
+  atomic_fetch_add_explicit(&s->contended, 1, memory_order_relaxed);
+  atomic_fetch_add_explicit(&s->wait_ns, waited, memory_order_relaxed);
+  unsigned long long prev =
+      atomic_load_explicit(&s->max_wait_ns, memory_order_relaxed);
+  while (waited > prev && !atomic_compare_exchange_weak_explicit(
+                              &s->max_wait_ns, &prev, waited,
+                              memory_order_relaxed, memory_order_relaxed)) {
+  }
+}
+
+static inline LockStats lock_stats_read(LockStatsAtomic *s) {
+  LockStats out = {atomic_load(&s->acquisitions), atomic_load(&s->contended),
+                   atomic_load(&s->wait_ns), atomic_load(&s->max_wait_ns)};
+  return out;
+}
+
+#define LOCK_STATS_FIELD LockStatsAtomic stats;
+#define LOCK_STATS_START(var) uint64_t var = lock_now_ns()
+#define LOCK_STATS_FAST(l) lock_stats_fast(&(l)->stats)
+#define LOCK_STATS_SLOW(l, start) lock_stats_slow(&(l)->stats, (start))
+#else
+#define LOCK_STATS_FIELD
+#define LOCK_STATS_START(var)
+#define LOCK_STATS_FAST(l) ((void)0)
+#define LOCK_STATS_SLOW(l, start) ((void)0)
+#endif
+
+// ---- Mutex: 0 = unlocked, 1 = locked, 2 = locked with sleepers ----
+
+typedef struct {
+  atomic_int state;
+  LOCK_STATS_FIELD
+} Mutex;
+
+static inline void mutex_init(Mutex *m) {
+  *m = (Mutex){0};
+  atomic_init(&m->state, 0);
+}
+
+static inline int mutex_trylock(Mutex *m) {
+  int expected = 0;
+  if (atomic_compare_exchange_strong_explicit(&m->state, &expected, 1,
+                                              memory_order_acquire,
+                                              memory_order_relaxed)) {
+    LOCK_STATS_FAST(m);
+    return 1;
+  }
+  return 0;
+}
+
+static inline void mutex_lock(Mutex *m) {
+  int expected = 0;
+  if (atomic_compare_exchange_strong_explicit(&m->state, &expected, 1,
+                                              memory_order_acquire,
+                                              memory_order_relaxed)) {
+    LOCK_STATS_FAST(m);
+    return;
+  }
+
+  LOCK_STATS_START(start);
+
+  // Spin while the holder is (probably) still running
+  int backoff = 1;
+  for (int i = 0; i < MUTEX_SPIN_LIMIT; i++) {
+    expected = 0;
+    if (atomic_load_explicit(&m->state, memory_order_relaxed) == 0 &&
+        atomic_compare_exchange_weak_explicit(&m->state, &expected, 1,
+                                              memory_order_acquire,
+                                              memory_order_relaxed)) {
+      LOCK_STATS_SLOW(m, start);
+      return;
+    }
+    backoff = mutex__spin_backoff(backoff);
+  }
+
+  // Park: mark the lock contended so the holder knows to wake us
+  while (atomic_exchange_explicit(&m->state, 2, memory_order_acquire) != 0)
+    mutex__futex_wait(&m->state, 2);
+  LOCK_STATS_SLOW(m, start);
+}
+
+static inline void mutex_unlock(Mutex *m) {
+  if (atomic_exchange_explicit(&m->state, 0, memory_order_release) == 2)
+    mutex__futex_wake(&m->state, 1);
+}
+
+static inline void mutex_destroy(Mutex *m) { (void)m; }
+
+// ---- RwLock: state = reader count, or RWLOCK_WRITER when write-held ----
+//
+// Sleepers wait on `epoch`, which every waking unlock bumps, rather than on
+// `state` itself: the state can return to an old value (0 -> writer -> 0)
+// between a waiter's check and its futex call, the epoch never does.
+
+#define RWLOCK_WRITER INT_MIN
+
+typedef struct {
+  atomic_int state;
+  atomic_int writers_waiting;
+  atomic_int sleepers;
+  atomic_int epoch;
+  LOCK_STATS_FIELD
+} RwLock;
+
+static inline void rwlock_init(RwLock *l) {
+  *l = (RwLock){0};
+  atomic_init(&l->state, 0);
+  atomic_init(&l->writers_waiting, 0);
+  atomic_init(&l->sleepers, 0);
+  atomic_init(&l->epoch, 0);
+}
+
+static inline void rwlock__wake(RwLock *l) {
+  atomic_fetch_add(&l->epoch, 1);
+  if (atomic_load(&l->sleepers) > 0)
+    mutex__futex_wake(&l->epoch, INT_MAX);
+}
+
+static inline int rwlock__try_read(RwLock *l) {
+  int s = atomic_load_explicit(&l->state, memory_order_relaxed);
+  while (s >= 0 &&
+         !atomic_load_explicit(&l->writers_waiting, memory_order_relaxed)) {
+    if (atomic_compare_exchange_weak_explicit(&l->state, &s, s + 1,
+                                              memory_order_acquire,
+                                              memory_order_relaxed))
+      return 1;
+  }
+  return 0;
+}
+
+static inline int rwlock__try_write(RwLock *l) {
+  int expected = 0;
+  return atomic_compare_exchange_strong_explicit(
+      &l->state, &expected, RWLOCK_WRITER, memory_order_acquire,
+      memory_order_relaxed);
+}
+
+// Spin with backoff, then sleep until an unlock; returns once try() succeeds
+static inline void rwlock__acquire_slow(RwLock *l, int (*try)(RwLock *)) {
+  int backoff = 1;
+  for (int i = 0; i < MUTEX_SPIN_LIMIT; i++) {
+    if (try(l))
+      return;
+    backoff = mutex__spin_backoff(backoff);
+  }
+  for (;;) {
+    atomic_fetch_add(&l->sleepers, 1);
+    int epoch = atomic_load(&l->epoch);
+    int acquired = try(l);
+    if (!acquired)
+      mutex__futex_wait(&l->epoch, epoch);
+    atomic_fetch_sub(&l->sleepers, 1);
+    if (acquired || try(l))
+      return;
+  }
+}
+
+static inline void rwlock_read_lock(RwLock *l) {
+  if (rwlock__try_read(l)) {
+    LOCK_STATS_FAST(l);
+    return;
+  }
+  LOCK_STATS_START(start);
+  rwlock__acquire_slow(l, rwlock__try_read);
+  LOCK_STATS_SLOW(l, start);
+}
+
+static inline void rwlock_read_unlock(RwLock *l) {
+  if (atomic_fetch_sub(&l->state, 1) == 1)
+    rwlock__wake(l); // last reader out lets a waiting writer in
+}
+
+static inline void rwlock_write_lock(RwLock *l) {
+  if (rwlock__try_write(l)) {
+    LOCK_STATS_FAST(l);
+    return;
+  }
+  LOCK_STATS_START(start);
+  atomic_fetch_add(&l->writers_waiting, 1); // holds off new readers
+  rwlock__acquire_slow(l, rwlock__try_write);
+  atomic_fetch_sub(&l->writers_waiting, 1);
+  LOCK_STATS_SLOW(l, start);
+}
+
+static inline void rwlock_write_unlock(RwLock *l) {
+  atomic_store(&l->state, 0);
+  rwlock__wake(l);
+}
+
+static inline void rwlock_destroy(RwLock *l) { (void)l; }
+
+#ifdef MUTEX_STATS
+static inline LockStats mutex_stats(Mutex *m) {
+  return lock_stats_read(&m->stats);
+}
+static inline LockStats rwlock_stats(RwLock *l) {
+  return lock_stats_read(&l->stats);
+}
+#endif
+
+#else // pthread fallback
 
 typedef pthread_mutex_t Mutex;
+typedef pthread_rwlock_t RwLock;
 
 static inline void mutex_init(Mutex *m) { pthread_mutex_init(m, NULL); }
 static inline void mutex_lock(Mutex *m) { pthread_mutex_lock(m); }
+static inline int mutex_trylock(Mutex *m) {
+  return pthread_mutex_trylock(m) == 0;
+}
 static inline void mutex_unlock(Mutex *m) { pthread_mutex_unlock(m); }
 static inline void mutex_destroy(Mutex *m) { pthread_mutex_destroy(m); }
 
+static inline void rwlock_init(RwLock *l) {
+  pthread_rwlockattr_t attr;
+  pthread_rwlockattr_init(&attr);
+  // The kind is an enum constant, not a macro, so test for glibc itself;
+  // __USE_GNU says _GNU_SOURCE was in effect for its headers
+#if defined(__GLIBC__) && defined(__USE_GNU)
+  pthread_rwlockattr_setkind_np(&attr,
+                                PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+  pthread_rwlock_init(l, &attr);
+  pthread_rwlockattr_destroy(&attr);
+}
+static inline void rwlock_read_lock(RwLock *l) { pthread_rwlock_rdlock(l); }
+static inline void rwlock_read_unlock(RwLock *l) { pthread_rwlock_unlock(l); }
+static inline void rwlock_write_lock(RwLock *l) { pthread_rwlock_wrlock(l); }
+static inline void rwlock_write_unlock(RwLock *l) { pthread_rwlock_unlock(l); }
+static inline void rwlock_destroy(RwLock *l) { pthread_rwlock_destroy(l); }
+
+#endif
+
 #endif
@@ -0,0 +1,117 @@
+// mutex_wrapper_bench.c — contention check for mutex_wrapper.h
+//
+// Compile (futex locks, then the pthread fallback):
+//   gcc -std=c11 -O2 -pthread mutex_wrapper_bench.c -o mutex_wrapper_bench
+//   gcc -std=c11 -O2 -pthread -DMUTEX_USE_PTHREAD mutex_wrapper_bench.c
+//
+// Run:
+//   ./mutex_wrapper_bench [ops per thread]     (default 200000)
+//
+// 1, 2, 4 and 8 threads hammer one lock:
+//   mutex   — every thread bumps two counters under the Mutex; each bump
+//             is a non-atomic read-modify-write, so a lost update means
+//             the lock let two holders in
+//   rwlock  — one writer in eight; writers bump both fields of a pair,
+//             readers check the two are equal (a torn pair means a reader
+//             ran alongside a writer)
+// Both must end with exact totals.
+#define _GNU_SOURCE
+#include "mutex_wrapper.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_THREADS 8
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int ops = 200000;
+
+static Mutex mutex;
+static RwLock rwlock;
+static long counter_a, counter_b; // guarded by mutex
+static long pair[2];              // guarded by rwlock
+static long torn[MAX_THREADS];    // per thread, so unguarded
+
+static void *mutex_worker(void *arg) {
+  (void)arg;
+  for (int i = 0; i < ops; i++) {
+    mutex_lock(&mutex);
+    counter_a++;
+    counter_b += 2;
+    mutex_unlock(&mutex);
+  }
+  return NULL;
+}
+
+static void *rwlock_worker(void *arg) {
+  int id = (int)(intptr_t)arg;
+  for (int i = 0; i < ops; i++) {
+    if (i % 8 == id % 8) {
+      rwlock_write_lock(&rwlock);
+      pair[0]++;
+      pair[1]++;
+      rwlock_write_unlock(&rwlock);
+    } else {
+      rwlock_read_lock(&rwlock);
+      if (pair[0] != pair[1])
+        torn[id]++;
+      rwlock_read_unlock(&rwlock);
+    }
+  }
+  return NULL;
+}
+
+// Runs `threads` copies of fn; returns lock operations per second
+static double run(void *(*fn)(void *), int threads) {
+  pthread_t tid[MAX_THREADS];
+  double t0 = now_sec();
+  for (int t = 0; t < threads; t++)
+    pthread_create(&tid[t], NULL, fn, (void *)(intptr_t)t);
+  for (int t = 0; t < threads; t++)
+    pthread_join(tid[t], NULL);
+  return (double)ops * threads / (now_sec() - t0);
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1)
+    ops = atoi(argv[1]);
+#if defined(__linux__) && !defined(MUTEX_USE_PTHREAD)
+  printf("futex locks, %d ops per thread\n", ops);
+#else
+  printf("pthread locks, %d ops per thread\n", ops);
+#endif
+  for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    mutex_init(&mutex);
+    counter_a = counter_b = 0;
+    double rate = run(mutex_worker, threads);
+    assert(counter_a == (long)ops * threads);
+    assert(counter_b == 2 * counter_a);
+    mutex_destroy(&mutex);
+    printf("  mutex   %d thread%s %7.1f M ops/s\n", threads,
+           threads == 1 ? " " : "s", rate / 1e6);
+
+    rwlock_init(&rwlock);
+    pair[0] = pair[1] = 0;
+    long writes = 0, torn_total = 0;
+    for (int t = 0; t < threads; t++) {
+      torn[t] = 0;
+      for (int i = 0; i < ops; i++)
+        writes += i % 8 == t % 8;
+    }
+    rate = run(rwlock_worker, threads);
+    for (int t = 0; t < threads; t++)
+      torn_total += torn[t];
+    assert(pair[0] == writes && pair[1] == writes);
+    assert(torn_total == 0);
+    rwlock_destroy(&rwlock);
+    printf("  rwlock  %d thread%s %7.1f M ops/s\n", threads,
+           threads == 1 ? " " : "s", rate / 1e6);
+  }
+  return 0;
+}
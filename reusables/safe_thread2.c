@@ -1,16 +1,23 @@
+// Double-checked once: after the first call, init_once is one acquire load.
+// The mutex is only taken while the value may still be uninitialized.
+// Reusable, generic version: lib/once.h (lazy_t / lazy_get / LAZY_STATIC).
 #define ONCE_INIT {.mutex = PTHREAD_MUTEX_INITIALIZER}
 
 typedef struct {
   pthread_mutex_t mutex;
-  int inited;
+  atomic_int inited;
   SomeType value;
 } Once;
 
-void init_once(Once *o) {
+SomeType *init_once(Once *o) {
+  if (atomic_load_explicit(&o->inited, memory_order_acquire))
+    return &o->value; // fast path: no lock
+
   pthread_mutex_lock(&o->mutex);
-  if (!o->inited) {
+  if (!atomic_load_explicit(&o->inited, memory_order_relaxed)) {
     o->value = really_expensive_init();
-    o->inited = 1;
+    atomic_store_explicit(&o->inited, 1, memory_order_release);
   }
   pthread_mutex_unlock(&o->mutex);
+  return &o->value;
 }
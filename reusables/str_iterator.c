@@ -1,3 +1,5 @@
+#include <string.h>
+
 typedef struct {
   char *start;
   char *end;
@@ -12,4 +14,13 @@ void split_init(StrSplit *it, char *s, char sep) {
 }
 int split_next(StrSplit *it, char **tok, size_t *len) {
   // returns 0 when done
+  if (it->next > it->end)
+    return 0;
+  char *p = memchr(it->next, it->sep, (size_t)(it->end - it->next));
+  if (!p)
+    p = it->end; // last token runs to the end; next call reports done
+  *tok = it->next;
+  *len = (size_t)(p - it->next);
+  it->next = p + 1;
+  return 1;
 }